@@ -0,0 +1,342 @@
+// Times each day's part 1 and part 2 and reports ns/op, allocations and throughput, optionally as JSON.
+//
+// Build: every day source with -DAOC_NO_MAIN, plus common/*.cpp, gen/Generators.cpp and this file.
+// Usage: bench [--json <file>] [--label <text>] [--min-time-ms <n>] [--seed <n>] [--scales <n,n,...>]
+//              [--batch <n> [--threads <n>]] [<workload>...]
+//   where a workload is <day>:<input path>, or <day>@<scale> for a generated input, or 4w@<scale> for generated
+//   scratchcards with hundreds of numbers a card.
+//   With no workloads, every day is run on generated inputs at each of --scales (default 1,10), plus 4w.
+//   --batch times days that have a batch solver on n inputs at once (n seeds from --seed on, or n copies of a file),
+//   against solving the same n inputs one by one; both are reported per input.
+
+#include <algorithm>
+#include <chrono>
+#include <fmt/format.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/AllocStats.h"
+#include "../common/Days.h"
+#include "../common/Input.h"
+#include "../common/ThreadPool.h"
+#include "../gen/Generators.h"
+
+namespace {
+
+struct Workload {
+    int day;
+    std::string label; // where the input came from, eg. its path
+    std::string input;
+};
+
+struct Result {
+    int day;
+    int part;
+    std::string label;
+    std::size_t input_bytes;
+    aoc::Answer answer;
+    std::size_t iterations;
+    double ns_per_op;
+    double allocs_per_op;
+    double bytes_allocated_per_op;
+    double mb_per_s;
+};
+
+struct Options {
+    std::string json_path;
+    std::string run_label;
+    std::chrono::milliseconds min_time {200};
+    std::uint64_t seed = 1;
+    std::vector<unsigned> scales {1, 10};
+    std::size_t batch_size = 0;
+    std::size_t no_of_threads = 1;
+    std::vector<std::string> workload_args;
+};
+
+struct BatchWorkload {
+    int day;
+    std::string label;
+    std::vector<std::string> inputs;
+};
+
+volatile aoc::Answer sink; // keeps the timed calls from being optimized away
+
+struct Timing {
+    std::size_t iterations;
+    double median_ns;
+    aoc::AllocStats allocs; // over all iterations
+};
+
+template<typename F>
+Timing time_op(F op, std::chrono::nanoseconds min_time) {
+    /// Runs `op` until it has taken `min_time` in total and at least 3 times. Expects a warm-up run already done
+    using Clock = std::chrono::steady_clock;
+    std::vector<std::chrono::nanoseconds> samples;
+    std::chrono::nanoseconds total {0};
+
+    const aoc::AllocStats allocs_before = aoc::thread_alloc_stats();
+    while (total < min_time || samples.size() < 3) {
+        const auto start = Clock::now();
+        op();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+        samples.push_back(elapsed);
+        total += elapsed;
+    }
+    const aoc::AllocStats allocs = aoc::thread_alloc_stats() - allocs_before;
+
+    std::ranges::nth_element(samples, begin(samples) + static_cast<long>(samples.size() / 2));
+    return {samples.size(), static_cast<double>(samples[samples.size() / 2].count()), allocs};
+}
+
+Result to_result(int day, int part, std::string label, std::size_t input_bytes, aoc::Answer answer,
+                 const Timing& timing, std::size_t ops_per_iteration) {
+    /// `input_bytes` and the per-op figures are per input, even when one iteration solves several
+    const double ops = static_cast<double>(timing.iterations * ops_per_iteration);
+    const double ns_per_op = timing.median_ns / static_cast<double>(ops_per_iteration);
+    return {
+        .day = day,
+        .part = part,
+        .label = std::move(label),
+        .input_bytes = input_bytes,
+        .answer = answer,
+        .iterations = timing.iterations,
+        .ns_per_op = ns_per_op,
+        .allocs_per_op = static_cast<double>(timing.allocs.count) / ops,
+        .bytes_allocated_per_op = static_cast<double>(timing.allocs.bytes) / ops,
+        .mb_per_s = (ns_per_op == 0) ? 0 : static_cast<double>(input_bytes) * 1e3 / ns_per_op
+    };
+}
+
+Result time_part(const Workload& workload, int part, std::chrono::nanoseconds min_time) {
+    const aoc::Day& day = aoc::day(workload.day);
+    const aoc::PartSolver solve = (part == 1) ? day.part_1 : day.part_2;
+
+    const aoc::Answer answer = solve(workload.input); // warm-up, and the answer we report
+    const Timing timing = time_op([&](){ sink = solve(workload.input); }, min_time);
+    return to_result(workload.day, part, workload.label, workload.input.size(), answer, timing, 1);
+}
+
+std::vector<Result> time_batch(const BatchWorkload& workload, int part, std::chrono::nanoseconds min_time,
+                               aoc::ThreadPool* pool) {
+    /// The same inputs solved one by one, then as a batch. The answers are checked against each other
+    const aoc::Day& day = aoc::day(workload.day);
+    const aoc::PartSolver solve = (part == 1) ? day.part_1 : day.part_2;
+    const aoc::BatchSolver solve_batch = (part == 1) ? day.batch_part_1 : day.batch_part_2;
+
+    const std::vector<std::string_view> inputs {workload.inputs.begin(), workload.inputs.end()};
+    std::size_t total_bytes = 0;
+    std::vector<aoc::Answer> answers;
+    for (const std::string_view input : inputs) {
+        answers.push_back(solve(input));
+        total_bytes += input.size();
+    }
+    if (solve_batch(inputs, pool) != answers) {
+        throw std::runtime_error("Batch answers differ from single solves");
+    }
+
+    const Timing singles = time_op([&](){
+        for (const std::string_view input : inputs) {
+            sink = solve(input);
+        }
+    }, min_time);
+    const Timing batch = time_op([&](){ sink = solve_batch(inputs, pool).back(); }, min_time);
+
+    const std::size_t bytes_per_input = total_bytes / inputs.size();
+    return {
+        to_result(workload.day, part, fmt::format("{} singles of {}", inputs.size(), workload.label),
+                  bytes_per_input, answers.front(), singles, inputs.size()),
+        to_result(workload.day, part, fmt::format("batch of {} {} on {} threads", inputs.size(), workload.label,
+                                                  pool == nullptr ? 1 : pool->size()),
+                  bytes_per_input, answers.front(), batch, inputs.size())
+    };
+}
+
+std::string json_escape(std::string_view str) {
+    std::string escaped;
+    for (const char c : str) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            default: escaped += c; break;
+        }
+    }
+    return escaped;
+}
+
+void write_json(std::FILE* out, const Options& options, const std::vector<Result>& results) {
+    fmt::print(out, "{{\n  \"label\": \"{}\",\n  \"results\": [\n", json_escape(options.run_label));
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        fmt::print(out,
+                   "    {{\"day\": {}, \"part\": {}, \"input\": \"{}\", \"input_bytes\": {}, \"answer\": {}, "
+                   "\"iterations\": {}, \"ns_per_op\": {:.0f}, \"allocs_per_op\": {:.1f}, "
+                   "\"bytes_allocated_per_op\": {:.0f}, \"mb_per_s\": {:.2f}}}{}\n",
+                   r.day, r.part, json_escape(r.label), r.input_bytes, r.answer,
+                   r.iterations, r.ns_per_op, r.allocs_per_op,
+                   r.bytes_allocated_per_op, r.mb_per_s, (i + 1 == results.size()) ? "" : ",");
+    }
+    fmt::print(out, "  ]\n}}\n");
+}
+
+Workload generated_workload(int day, unsigned scale, std::uint64_t seed) {
+    return {day, fmt::format("generated x{} seed {}", scale, seed), aoc::gen::generate(day, scale, seed)};
+}
+
+Workload wide_scratchcards_workload(unsigned scale, std::uint64_t seed) {
+    return {4, fmt::format("wide generated x{} seed {}", scale, seed), aoc::gen::generate_wide_scratchcards(scale, seed)};
+}
+
+Workload load_workload(std::string_view arg, std::uint64_t seed) {
+    /// <day>:<input path>, <day>@<scale> or 4w@<scale>
+    const auto separator = arg.find_first_of(":@");
+    if (separator == std::string_view::npos) {
+        throw std::invalid_argument("Expected <day>:<input path>, <day>@<scale> or 4w@<scale>");
+    }
+    const std::string rest {arg.substr(separator + 1)};
+    if (arg.substr(0, separator) == "4w" && arg[separator] == '@') {
+        return wide_scratchcards_workload(static_cast<unsigned>(std::stoul(rest)), seed);
+    }
+    const int day = std::stoi(std::string(arg.substr(0, separator)));
+    if (arg[separator] == '@') {
+        return generated_workload(day, static_cast<unsigned>(std::stoul(rest)), seed);
+    }
+    const aoc::MappedFile file(rest);
+    return {day, rest, std::string(file.view())};
+}
+
+BatchWorkload load_batch_workload(std::string_view arg, std::uint64_t seed, std::size_t batch_size) {
+    /// Like load_workload, but with `batch_size` inputs: one per seed for <day>@<scale>, or copies of the file
+    const Workload first = load_workload(arg, seed);
+    BatchWorkload batch {first.day, first.label, {first.input}};
+    const bool is_generated = arg.find('@') != std::string_view::npos;
+    for (std::size_t i = 1; i < batch_size; ++i) {
+        batch.inputs.push_back(is_generated ? load_workload(arg, seed + i).input : first.input);
+    }
+    if (is_generated) {
+        batch.label = fmt::format("{}..{}", batch.label, seed + batch_size - 1);
+    }
+    return batch;
+}
+
+std::vector<unsigned> parse_scales(std::string_view list) {
+    std::vector<unsigned> scales;
+    while (!list.empty()) {
+        const auto comma = list.find(',');
+        scales.push_back(static_cast<unsigned>(std::stoul(std::string(list.substr(0, comma)))));
+        list = (comma == std::string_view::npos) ? std::string_view{} : list.substr(comma + 1);
+    }
+    return scales;
+}
+
+Options parse_args(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--json" && has_value) {
+            options.json_path = argv[++i];
+        }
+        else if (arg == "--label" && has_value) {
+            options.run_label = argv[++i];
+        }
+        else if (arg == "--min-time-ms" && has_value) {
+            options.min_time = std::chrono::milliseconds(std::stoi(argv[++i]));
+        }
+        else if (arg == "--seed" && has_value) {
+            options.seed = std::stoull(argv[++i]);
+        }
+        else if (arg == "--scales" && has_value) {
+            options.scales = parse_scales(argv[++i]);
+        }
+        else if (arg == "--batch" && has_value) {
+            options.batch_size = std::stoul(argv[++i]);
+        }
+        else if (arg == "--threads" && has_value) {
+            options.no_of_threads = std::stoul(argv[++i]);
+        }
+        else {
+            options.workload_args.emplace_back(arg);
+        }
+    }
+    return options;
+}
+
+}
+
+int main(int argc, char** argv) {
+
+    const Options options = parse_args(argc, argv);
+
+    std::vector<Result> results;
+    const auto report = [&](const Result& r){
+        fmt::print("day {:>2} part {} {:>12} B {:>14.0f} ns/op {:>10.1f} allocs/op {:>14.0f} B alloc/op {:>10.2f} MB/s  {}\n",
+                   r.day, r.part, r.input_bytes, r.ns_per_op, r.allocs_per_op,
+                   r.bytes_allocated_per_op, r.mb_per_s, r.label);
+        results.push_back(r);
+    };
+
+    if (options.batch_size > 0) {
+        std::vector<std::string> workload_args = options.workload_args;
+        if (workload_args.empty()) {
+            for (const aoc::Day& day : aoc::all_days()) {
+                if (day.batch_part_1 == nullptr) continue;
+                for (const unsigned scale : options.scales) {
+                    workload_args.push_back(fmt::format("{}@{}", day.number, scale));
+                }
+            }
+        }
+        std::optional<aoc::ThreadPool> pool;
+        if (options.no_of_threads > 1) {
+            pool.emplace(options.no_of_threads);
+        }
+        for (const auto& arg : workload_args) {
+            const BatchWorkload workload = load_batch_workload(arg, options.seed, options.batch_size);
+            if (aoc::day(workload.day).batch_part_1 == nullptr) {
+                throw std::invalid_argument("No batch solver for that day");
+            }
+            for (const int part : {1, 2}) {
+                for (const Result& r : time_batch(workload, part, options.min_time, pool ? &*pool : nullptr)) {
+                    report(r);
+                }
+            }
+        }
+    }
+    else {
+        std::vector<Workload> workloads;
+        for (const auto& arg : options.workload_args) {
+            workloads.push_back(load_workload(arg, options.seed));
+        }
+        if (workloads.empty()) {
+            for (const aoc::Day& day : aoc::all_days()) {
+                for (const unsigned scale : options.scales) {
+                    workloads.push_back(generated_workload(day.number, scale, options.seed));
+                }
+            }
+            for (const unsigned scale : options.scales) {
+                workloads.push_back(wide_scratchcards_workload(scale, options.seed));
+            }
+        }
+        for (const Workload& workload : workloads) {
+            for (const int part : {1, 2}) {
+                report(time_part(workload, part, options.min_time));
+            }
+        }
+    }
+
+    if (!options.json_path.empty()) {
+        std::FILE* out = (options.json_path == "-") ? stdout : std::fopen(options.json_path.c_str(), "w");
+        if (out == nullptr) {
+            throw std::runtime_error("Unable to open file");
+        }
+        write_json(out, options, results);
+        if (out != stdout) {
+            std::fclose(out);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "AllocStats.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace aoc {
+
+namespace {
+
+thread_local AllocStats stats; // NB: trivial type, so no thread_local init guard inside operator new
+
+void record(std::size_t size) {
+    ++stats.count;
+    stats.bytes += size;
+}
+
+}
+
+AllocStats thread_alloc_stats() {
+    return stats;
+}
+
+}
+
+// Replacement global allocation functions. The array and nothrow forms forward to these.
+
+void* operator new(std::size_t size) {
+    aoc::record(size);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    aoc::record(size);
+    const auto align = static_cast<std::size_t>(alignment);
+    const std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align; // aligned_alloc wants a multiple
+    if (void* ptr = std::aligned_alloc(align, rounded)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
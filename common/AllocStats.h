@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+namespace aoc {
+
+struct AllocStats {
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;
+};
+
+[[nodiscard]] inline AllocStats operator-(AllocStats after, AllocStats before) {
+    return {after.count - before.count, after.bytes - before.bytes};
+}
+
+// Allocations made through the global operator new by the calling thread so far.
+// Only counted in binaries that link AllocStats.cpp, which replaces the global operator new.
+[[nodiscard]] AllocStats thread_alloc_stats();
+
+}
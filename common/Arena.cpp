@@ -0,0 +1,65 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace aoc {
+
+namespace {
+
+thread_local int t_scope_depth = 0;
+
+}
+
+void* Arena::Upstream::do_allocate(std::size_t bytes, std::size_t alignment) {
+    m_bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void Arena::Upstream::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+bool Arena::Upstream::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+Arena::Arena(std::size_t initial_capacity, std::size_t max_capacity)
+        : m_capacity{std::min(initial_capacity, max_capacity)}
+        , m_max_capacity{max_capacity}
+        , m_buffer{std::make_unique_for_overwrite<std::byte[]>(m_capacity)}
+{
+    m_resource.emplace(m_buffer.get(), m_capacity, &m_upstream);
+}
+
+void Arena::reset() {
+    if (m_upstream.bytes() == 0) {
+        m_resource->release(); // NB: rewinds to the start of m_buffer
+        return;
+    }
+    m_resource.reset(); // returns the overflow blocks to the heap
+    const std::size_t capacity = std::min(std::bit_ceil(m_capacity + m_upstream.bytes()), m_max_capacity);
+    if (capacity != m_capacity) {
+        m_capacity = capacity;
+        m_buffer = std::make_unique_for_overwrite<std::byte[]>(m_capacity);
+    }
+    m_upstream.clear();
+    m_resource.emplace(m_buffer.get(), m_capacity, &m_upstream);
+}
+
+Arena& thread_arena() {
+    thread_local Arena arena;
+    return arena;
+}
+
+ScratchScope::ScratchScope() {
+    ++t_scope_depth;
+}
+
+ScratchScope::~ScratchScope() {
+    if (--t_scope_depth == 0) {
+        thread_arena().reset();
+    }
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace aoc {
+
+class Arena {
+    /// Monotonic scratch memory: allocations are bumped off one buffer and all freed at once by reset().
+    /// Whatever spilled past the buffer during a solve is folded into it on reset, so a warm arena serves
+    /// every later solve of the same size without touching the general-purpose allocator. The buffer stops growing
+    /// at max_capacity, so one outsized solve can't pin that much memory to the thread for good: past that, spills
+    /// go to the heap and back on every reset.
+    class Upstream : public std::pmr::memory_resource {
+        /// Counts what the arena has had to take from the heap since its last reset
+        std::size_t m_bytes = 0;
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    public:
+        [[nodiscard]] std::size_t bytes() const { return m_bytes; }
+        void clear() { m_bytes = 0; }
+    };
+
+    std::size_t m_capacity;
+    std::size_t m_max_capacity;
+    std::unique_ptr<std::byte[]> m_buffer;
+    Upstream m_upstream;
+    std::optional<std::pmr::monotonic_buffer_resource> m_resource;
+
+public:
+    explicit Arena(std::size_t initial_capacity = 64 * 1024, std::size_t max_capacity = 64 * 1024 * 1024);
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    [[nodiscard]] std::pmr::memory_resource* resource() { return &*m_resource; }
+    [[nodiscard]] std::size_t capacity() const { return m_capacity; }
+    [[nodiscard]] std::size_t max_capacity() const { return m_max_capacity; }
+
+    // Frees everything allocated from resource(). Anything still pointing into the arena is left dangling.
+    void reset();
+};
+
+// The calling thread's arena, so solves running side by side on a pool never share one
+[[nodiscard]] Arena& thread_arena();
+[[nodiscard]] inline std::pmr::memory_resource* scratch() { return thread_arena().resource(); }
+
+class ScratchScope {
+    /// Resets the calling thread's arena when the outermost scope on that thread ends. Opened at the top of a
+    /// solve_part_N, before anything allocates from scratch(), so all of it is gone once the answer is returned.
+public:
+    ScratchScope();
+    ~ScratchScope();
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+};
+
+}
@@ -0,0 +1,43 @@
+#include "Days.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace aoc {
+
+namespace {
+
+constexpr std::array days {
+    Day{1, q1::solve_part_1, q1::solve_part_2},
+    Day{2, q2::solve_part_1, q2::solve_part_2},
+    Day{3, q3::solve_part_1, q3::solve_part_2},
+    Day{4, q4::solve_part_1, q4::solve_part_2},
+    Day{5, q5::solve_part_1, q5::solve_part_2},
+    Day{6, q6::solve_part_1, q6::solve_part_2, q6::solve_part_1_batch, q6::solve_part_2_batch},
+    Day{7, q7::solve_part_1, q7::solve_part_2, q7::solve_part_1_batch, q7::solve_part_2_batch},
+    Day{8, q8::solve_part_1, q8::solve_part_2},
+    Day{9, q9::solve_part_1, q9::solve_part_2, q9::solve_part_1_batch, q9::solve_part_2_batch},
+    Day{10, q10::solve_part_1, q10::solve_part_2},
+    Day{11, q11::solve_part_1, q11::solve_part_2},
+    Day{13, q13::solve_part_1, q13::solve_part_2},
+    Day{14, q14::solve_part_1, q14::solve_part_2},
+    Day{15, q15::solve_part_1, q15::solve_part_2},
+    Day{16, q16::solve_part_1, q16::solve_part_2},
+};
+
+}
+
+std::span<const Day> all_days() {
+    return days;
+}
+
+const Day& day(int number) {
+    const auto it = std::ranges::find(days, number, &Day::number);
+    if (it == days.end()) {
+        throw std::out_of_range("No solver for that day");
+    }
+    return *it;
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace aoc {
+
+class ThreadPool;
+
+using Answer = std::int64_t;
+using PartSolver = Answer (*)(std::string_view input);
+
+// One answer per input, in order. Spreads the work over `pool` if given, else runs on the calling thread.
+using BatchSolver = std::vector<Answer> (*)(std::span<const std::string_view> inputs, ThreadPool* pool);
+
+struct Day {
+    int number;
+    PartSolver part_1;
+    PartSolver part_2;
+    BatchSolver batch_part_1 = nullptr; // only for days whose inputs are small enough that per-input overhead dominates
+    BatchSolver batch_part_2 = nullptr;
+};
+
+[[nodiscard]] std::span<const Day> all_days();
+[[nodiscard]] const Day& day(int number);
+
+}
+
+// Each day's entry points. Build the day sources with AOC_NO_MAIN to link several of them into one binary.
+
+namespace q1 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q2 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q3 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q4 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q5 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q6 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q7 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q8 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q9 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q10 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q11 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q13 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q14 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q15 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+namespace q16 { aoc::Answer solve_part_1(std::string_view input); aoc::Answer solve_part_2(std::string_view input); }
+
+// Batch entry points, for the days that have them (see Day::batch_part_1)
+
+namespace q6 {
+std::vector<aoc::Answer> solve_part_1_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool);
+std::vector<aoc::Answer> solve_part_2_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool);
+}
+namespace q7 {
+std::vector<aoc::Answer> solve_part_1_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool);
+std::vector<aoc::Answer> solve_part_2_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool);
+}
+namespace q9 {
+std::vector<aoc::Answer> solve_part_1_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool);
+std::vector<aoc::Answer> solve_part_2_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool);
+}
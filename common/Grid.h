@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace aoc {
+
+template<typename T>
+class StridedRange {
+    /// Non-owning range over `size` elements spaced `step` apart, eg. a grid column.
+    T* m_first = nullptr;
+    std::size_t m_size = 0;
+    std::ptrdiff_t m_step = 1;
+
+public:
+    class iterator {
+        T* m_first = nullptr;
+        std::ptrdiff_t m_step = 1;
+        std::ptrdiff_t m_ix = 0; // NB: indexed rather than pointer-stepped, so end() never points past the buffer
+    public:
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(T* first, std::ptrdiff_t step, std::ptrdiff_t ix) : m_first{first}, m_step{step}, m_ix{ix} {}
+
+        T& operator*() const { return m_first[m_ix * m_step]; }
+        iterator& operator++() { ++m_ix; return *this; }
+        iterator operator++(int) { auto prev = *this; ++m_ix; return prev; }
+        friend bool operator==(const iterator& a, const iterator& b) { return a.m_ix == b.m_ix; }
+    };
+
+    StridedRange() = default;
+    StridedRange(T* first, std::size_t size, std::ptrdiff_t step) : m_first{first}, m_size{size}, m_step{step} {}
+
+    [[nodiscard]] iterator begin() const { return {m_first, m_step, 0}; }
+    [[nodiscard]] iterator end() const { return {m_first, m_step, static_cast<std::ptrdiff_t>(m_size)}; }
+    [[nodiscard]] std::size_t size() const { return m_size; }
+    [[nodiscard]] bool empty() const { return m_size == 0; }
+    T& operator[](std::size_t ix) const { return m_first[static_cast<std::ptrdiff_t>(ix) * m_step]; }
+};
+
+}
+
+template<typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<aoc::StridedRange<T>> = true;
+
+namespace aoc {
+
+template<typename T>
+class GridView {
+    /// Non-owning, row-major view of a 2D block of cells.
+    /// `stride` is the distance between the starts of consecutive rows, so a view can sit directly on top of
+    /// newline-separated text (stride == width + 1) or on the interior of a padded Grid.
+    T* m_origin = nullptr;
+    std::size_t m_height = 0;
+    std::size_t m_width = 0;
+    std::ptrdiff_t m_row_stride = 0;
+    std::ptrdiff_t m_col_stride = 1;
+
+public:
+    GridView() = default;
+    GridView(T* origin, std::size_t height, std::size_t width, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride = 1)
+            : m_origin{origin}, m_height{height}, m_width{width}, m_row_stride{row_stride}, m_col_stride{col_stride}
+    { }
+
+    operator GridView<const T>() const requires (!std::is_const_v<T>) {
+        return {m_origin, m_height, m_width, m_row_stride, m_col_stride};
+    }
+
+    [[nodiscard]] std::size_t height() const { return m_height; }
+    [[nodiscard]] std::size_t width() const { return m_width; }
+    [[nodiscard]] std::ptrdiff_t stride() const { return m_row_stride; }
+    [[nodiscard]] bool empty() const { return m_height == 0 || m_width == 0; }
+
+    T& operator()(std::ptrdiff_t row, std::ptrdiff_t col) const {
+        /// NB: unchecked, and allowed to reach into the border of a padded Grid
+        return m_origin[row * m_row_stride + col * m_col_stride];
+    }
+
+    [[nodiscard]] StridedRange<T> row(std::size_t row_ix) const {
+        return {&(*this)(static_cast<std::ptrdiff_t>(row_ix), 0), m_width, m_col_stride};
+    }
+    [[nodiscard]] StridedRange<T> column(std::size_t col_ix) const {
+        return {&(*this)(0, static_cast<std::ptrdiff_t>(col_ix)), m_height, m_row_stride};
+    }
+    [[nodiscard]] std::span<T> row_span(std::size_t row_ix) const {
+        /// Contiguous row, for scans the compiler can vectorize. Not available on a transposed view.
+        assert(m_col_stride == 1);
+        return {&(*this)(static_cast<std::ptrdiff_t>(row_ix), 0), m_width};
+    }
+
+    [[nodiscard]] GridView transposed() const {
+        return {m_origin, m_width, m_height, m_col_stride, m_row_stride};
+    }
+};
+
+[[nodiscard]] inline GridView<const char> grid_view(std::string_view text) {
+    /// View newline-separated, equal-width rows in place (eg. straight over a MappedFile) without copying.
+    /// A trailing newline is optional.
+    if (text.empty()) return {};
+    const auto newline = text.find('\n');
+    const std::size_t width = (newline == std::string_view::npos) ? text.size() : newline;
+    const std::size_t stride = width + 1;
+    const std::size_t height = (text.size() + 1) / stride;
+    if (height * stride != text.size() + (text.back() == '\n' ? 0 : 1)) {
+        throw std::runtime_error("Grid rows are not all the same width");
+    }
+    return {text.data(), height, width, static_cast<std::ptrdiff_t>(stride)};
+}
+
+template<typename T>
+class Grid {
+    /// Owning, contiguous row-major grid. With `padding` > 0 the cells are surrounded by a border that is
+    /// addressable with negative / past-the-end indices, so neighbour lookups at the edge need no bounds checks.
+    std::vector<T> m_cells;
+    std::size_t m_height = 0;
+    std::size_t m_width = 0;
+    std::size_t m_padding = 0;
+
+    [[nodiscard]] std::size_t origin_ix() const { return m_padding * (m_width + 2 * m_padding) + m_padding; }
+    [[nodiscard]] std::size_t cell_ix(std::ptrdiff_t row, std::ptrdiff_t col) const {
+        return static_cast<std::size_t>(static_cast<std::ptrdiff_t>(origin_ix()) + row * stride() + col);
+    }
+
+public:
+    Grid() = default;
+
+    Grid(std::size_t height, std::size_t width, const T& fill, std::size_t padding = 0)
+            : m_cells((height + 2 * padding) * (width + 2 * padding), fill)
+            , m_height{height}, m_width{width}, m_padding{padding}
+    { }
+
+    template<typename U, typename Convert>
+    Grid(GridView<U> source, Convert convert)
+            : m_height{source.height()}, m_width{source.width()}
+    {
+        m_cells.reserve(m_height * m_width);
+        for (std::size_t row = 0; row < m_height; ++row) {
+            for (const auto& cell : source.row(row)) {
+                m_cells.push_back(convert(cell));
+            }
+        }
+    }
+
+    template<typename U, typename Convert>
+    Grid(GridView<U> source, Convert convert, std::size_t padding, const T& border)
+            : m_height{source.height()}, m_width{source.width()}, m_padding{padding}
+    {
+        const auto pad = static_cast<std::ptrdiff_t>(padding);
+        const auto height = static_cast<std::ptrdiff_t>(m_height);
+        const auto width = static_cast<std::ptrdiff_t>(m_width);
+        m_cells.reserve((m_height + 2 * padding) * (m_width + 2 * padding));
+        for (std::ptrdiff_t row = -pad; row < height + pad; ++row) {
+            for (std::ptrdiff_t col = -pad; col < width + pad; ++col) {
+                const bool is_border = row < 0 || col < 0 || row >= height || col >= width;
+                m_cells.push_back(is_border ? border : convert(source(row, col)));
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t height() const { return m_height; }
+    [[nodiscard]] std::size_t width() const { return m_width; }
+    [[nodiscard]] std::size_t padding() const { return m_padding; }
+    [[nodiscard]] std::ptrdiff_t stride() const { return static_cast<std::ptrdiff_t>(m_width + 2 * m_padding); }
+
+    [[nodiscard]] GridView<T> view() { return {m_cells.data() + origin_ix(), m_height, m_width, stride()}; }
+    [[nodiscard]] GridView<const T> view() const { return {m_cells.data() + origin_ix(), m_height, m_width, stride()}; }
+
+    T& operator()(std::ptrdiff_t row, std::ptrdiff_t col) { return m_cells[cell_ix(row, col)]; }
+    const T& operator()(std::ptrdiff_t row, std::ptrdiff_t col) const { return m_cells[cell_ix(row, col)]; }
+
+    [[nodiscard]] StridedRange<T> row(std::size_t row_ix) { return view().row(row_ix); }
+    [[nodiscard]] StridedRange<const T> row(std::size_t row_ix) const { return view().row(row_ix); }
+    [[nodiscard]] StridedRange<T> column(std::size_t col_ix) { return view().column(col_ix); }
+    [[nodiscard]] StridedRange<const T> column(std::size_t col_ix) const { return view().column(col_ix); }
+    [[nodiscard]] std::span<T> row_span(std::size_t row_ix) { return view().row_span(row_ix); }
+    [[nodiscard]] std::span<const T> row_span(std::size_t row_ix) const { return view().row_span(row_ix); }
+    [[nodiscard]] GridView<const T> transposed() const { return view().transposed(); }
+
+    [[nodiscard]] std::span<T> cells() { return m_cells; } // NB: includes the padded border
+    [[nodiscard]] std::span<const T> cells() const { return m_cells; }
+
+    friend bool operator==(const Grid& a, const Grid& b) = default;
+    friend auto operator<=>(const Grid& a, const Grid& b) = default;
+};
+
+}
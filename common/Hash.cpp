@@ -0,0 +1,110 @@
+#include "Hash.h"
+
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <fmt/format.h>
+#include <stdexcept>
+
+namespace aoc {
+
+namespace {
+
+std::uint64_t load_u64(const char* p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof v); // NB: little-endian only, like the reference implementation's x86 output
+    return v;
+}
+
+std::uint64_t fmix64(std::uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccd;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53;
+    k ^= k >> 33;
+    return k;
+}
+
+}
+
+Hash128 hash128(std::span<const char> bytes, std::uint64_t seed) {
+    constexpr std::uint64_t c1 = 0x87c37b91114253d5;
+    constexpr std::uint64_t c2 = 0x4cf5ad432745937f;
+
+    const char* data = bytes.data();
+    const std::size_t len = bytes.size();
+    const std::size_t no_of_blocks = len / 16;
+
+    std::uint64_t h1 = seed;
+    std::uint64_t h2 = seed;
+
+    for (std::size_t i = 0; i < no_of_blocks; ++i) {
+        std::uint64_t k1 = load_u64(data + i * 16);
+        std::uint64_t k2 = load_u64(data + i * 16 + 8);
+
+        k1 *= c1; k1 = std::rotl(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = std::rotl(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2; k2 = std::rotl(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = std::rotl(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const auto* tail = reinterpret_cast<const unsigned char*>(data + no_of_blocks * 16);
+    std::uint64_t k1 = 0;
+    std::uint64_t k2 = 0;
+    switch (len & 15) {
+        case 15: k2 ^= std::uint64_t{tail[14]} << 48; [[fallthrough]];
+        case 14: k2 ^= std::uint64_t{tail[13]} << 40; [[fallthrough]];
+        case 13: k2 ^= std::uint64_t{tail[12]} << 32; [[fallthrough]];
+        case 12: k2 ^= std::uint64_t{tail[11]} << 24; [[fallthrough]];
+        case 11: k2 ^= std::uint64_t{tail[10]} << 16; [[fallthrough]];
+        case 10: k2 ^= std::uint64_t{tail[9]} << 8; [[fallthrough]];
+        case 9:  k2 ^= std::uint64_t{tail[8]};
+                 k2 *= c2; k2 = std::rotl(k2, 33); k2 *= c1; h2 ^= k2;
+                 [[fallthrough]];
+        case 8:  k1 ^= std::uint64_t{tail[7]} << 56; [[fallthrough]];
+        case 7:  k1 ^= std::uint64_t{tail[6]} << 48; [[fallthrough]];
+        case 6:  k1 ^= std::uint64_t{tail[5]} << 40; [[fallthrough]];
+        case 5:  k1 ^= std::uint64_t{tail[4]} << 32; [[fallthrough]];
+        case 4:  k1 ^= std::uint64_t{tail[3]} << 24; [[fallthrough]];
+        case 3:  k1 ^= std::uint64_t{tail[2]} << 16; [[fallthrough]];
+        case 2:  k1 ^= std::uint64_t{tail[1]} << 8; [[fallthrough]];
+        case 1:  k1 ^= std::uint64_t{tail[0]};
+                 k1 *= c1; k1 = std::rotl(k1, 31); k1 *= c2; h1 ^= k1;
+                 break;
+        default: break;
+    }
+
+    h1 ^= len;
+    h2 ^= len;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+    h1 += h2;
+    h2 += h1;
+
+    return {h1, h2};
+}
+
+std::string to_hex(Hash128 hash) {
+    return fmt::format("{:016x}{:016x}", hash.high, hash.low);
+}
+
+Hash128 hash128_from_hex(std::string_view hex) {
+    Hash128 hash;
+    auto parse_half = [&](std::string_view half, std::uint64_t& out) {
+        const auto [end, err] = std::from_chars(half.data(), half.data() + half.size(), out, 16);
+        if (err != std::errc{} || end != half.data() + half.size()) {
+            throw std::invalid_argument("Expected a 128-bit hash as 32 hex digits");
+        }
+    };
+    if (hex.size() != 32) {
+        throw std::invalid_argument("Expected a 128-bit hash as 32 hex digits");
+    }
+    parse_half(hex.substr(0, 16), hash.high);
+    parse_half(hex.substr(16), hash.low);
+    return hash;
+}
+
+}
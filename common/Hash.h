@@ -0,0 +1,28 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace aoc {
+
+struct Hash128 {
+    std::uint64_t low = 0;
+    std::uint64_t high = 0;
+
+    friend bool operator==(const Hash128&, const Hash128&) = default;
+    friend auto operator<=>(const Hash128&, const Hash128&) = default;
+};
+
+// MurmurHash3 x64-128: fast and well distributed, but not cryptographic
+[[nodiscard]] Hash128 hash128(std::span<const char> bytes, std::uint64_t seed = 0);
+[[nodiscard]] inline Hash128 hash128(std::string_view bytes, std::uint64_t seed = 0) {
+    return hash128(std::span<const char>{bytes.data(), bytes.size()}, seed);
+}
+
+[[nodiscard]] std::string to_hex(Hash128 hash);
+[[nodiscard]] Hash128 hash128_from_hex(std::string_view hex); // throws std::invalid_argument unless 32 hex digits
+
+}
@@ -0,0 +1,109 @@
+#include "Input.h"
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace aoc {
+
+MappedFile::MappedFile(std::string_view file_name) {
+    const std::string path {file_name}; // open() needs a null-terminated path
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Unable to open file");
+    }
+
+    struct stat info{};
+    if (::fstat(fd, &info) == -1) {
+        ::close(fd);
+        throw std::runtime_error("Unable to stat file");
+    }
+
+    m_size = static_cast<std::size_t>(info.st_size);
+
+    if (m_size != 0) { // mmap() rejects zero-length mappings
+        void* mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Unable to map file");
+        }
+        ::madvise(mapping, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(mapping);
+    }
+
+    ::close(fd); // the mapping keeps its own reference to the file
+}
+
+MappedFile::~MappedFile() {
+    if (m_data != nullptr) {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_data{std::exchange(other.m_data, nullptr)}
+        , m_size{std::exchange(other.m_size, 0)}
+{ }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+    }
+    return *this;
+}
+
+std::string_view next_line(std::string_view& remaining) {
+    /// Pop the next line off the front of `remaining`, without its '\n'.
+    /// Mirrors std::getline: a trailing '\n' does not produce an extra empty line.
+    const auto newline = remaining.find('\n');
+    if (newline == std::string_view::npos) {
+        const std::string_view line = remaining;
+        remaining = {};
+        return line;
+    }
+    const std::string_view line = remaining.substr(0, newline);
+    remaining.remove_prefix(newline + 1);
+    return line;
+}
+
+std::vector<std::string_view> lines(std::string_view buffer) {
+    std::vector<std::string_view> vec;
+    while (!buffer.empty()) {
+        vec.push_back(next_line(buffer));
+    }
+    return vec;
+}
+
+std::pmr::vector<std::string_view> lines(std::string_view buffer, std::pmr::memory_resource* resource) {
+    std::pmr::vector<std::string_view> vec {resource};
+    while (!buffer.empty()) {
+        vec.push_back(next_line(buffer));
+    }
+    return vec;
+}
+
+std::pmr::vector<std::string_view> split(std::string_view str, char separator, std::pmr::memory_resource* resource) {
+    std::pmr::vector<std::string_view> tokens {resource};
+    std::size_t start = 0;
+    while (true) {
+        const auto end = str.find(separator, start);
+        if (end == std::string_view::npos) {
+            tokens.push_back(str.substr(start));
+            return tokens;
+        }
+        tokens.push_back(str.substr(start, end - start));
+        start = str.find_first_not_of(separator, end);
+        if (start == std::string_view::npos) {
+            tokens.emplace_back();
+            return tokens;
+        }
+    }
+}
+
+}
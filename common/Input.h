@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace aoc {
+
+class MappedFile {
+    /// Read-only memory mapping of a whole input file.
+    /// Every view handed out points into the mapping, so the MappedFile must outlive them.
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+
+public:
+    explicit MappedFile(std::string_view file_name);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    [[nodiscard]] std::span<const char> bytes() const { return {m_data, m_size}; }
+    [[nodiscard]] std::string_view view() const { return {m_data, m_size}; }
+    [[nodiscard]] std::size_t size() const { return m_size; }
+};
+
+[[nodiscard]] std::string_view next_line(std::string_view& remaining);
+[[nodiscard]] std::vector<std::string_view> lines(std::string_view buffer);
+[[nodiscard]] std::pmr::vector<std::string_view> lines(std::string_view buffer, std::pmr::memory_resource* resource);
+
+// Same tokens as boost::split with token_compress_on: a run of separators splits once, and a leading or trailing
+// run still yields an empty token (so an empty string is one empty token). Tokens point into `str`.
+[[nodiscard]] std::pmr::vector<std::string_view> split(std::string_view str, char separator,
+                                                       std::pmr::memory_resource* resource);
+
+}
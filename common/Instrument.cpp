@@ -0,0 +1,70 @@
+#include "Instrument.h"
+
+#include <algorithm>
+#include <atomic>
+#include <sys/resource.h>
+
+namespace aoc {
+
+namespace {
+
+std::atomic<bool> g_is_enabled = false;
+
+std::vector<PhaseStats>& thread_phases() {
+    thread_local std::vector<PhaseStats> phases = [](){
+        std::vector<PhaseStats> p;
+        p.reserve(32); // so recording a phase doesn't usually allocate inside the phases around it
+        return p;
+    }();
+    return phases;
+}
+
+}
+
+void enable_instrumentation(bool enabled) {
+    g_is_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool instrumentation_enabled() {
+    return g_is_enabled.load(std::memory_order_relaxed);
+}
+
+std::vector<PhaseStats> thread_phase_stats() {
+    return thread_phases();
+}
+
+void reset_thread_phase_stats() {
+    thread_phases().clear();
+}
+
+std::uint64_t peak_rss_bytes() {
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024; // NB: Linux reports kilobytes
+}
+
+Phase::Phase(std::string_view name) : m_name{name}, m_is_active{instrumentation_enabled()} {
+    if (!m_is_active) return;
+    m_allocs_at_start = thread_alloc_stats();
+    m_start = std::chrono::steady_clock::now();
+}
+
+Phase::~Phase() {
+    if (!m_is_active) return;
+    const auto wall = std::chrono::steady_clock::now() - m_start;
+    const AllocStats allocs = thread_alloc_stats() - m_allocs_at_start;
+
+    auto& phases = thread_phases();
+    auto it = std::ranges::find(phases, m_name, &PhaseStats::name);
+    if (it == phases.end()) {
+        phases.push_back({.name = m_name, .calls = 0, .wall = {}, .allocs = {}, .peak_rss_bytes = 0});
+        it = std::prev(phases.end());
+    }
+    ++it->calls;
+    it->wall += std::chrono::duration_cast<std::chrono::nanoseconds>(wall);
+    it->allocs.count += allocs.count;
+    it->allocs.bytes += allocs.bytes;
+    it->peak_rss_bytes = peak_rss_bytes();
+}
+
+}
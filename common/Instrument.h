@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "AllocStats.h"
+
+namespace aoc {
+
+struct PhaseStats {
+    std::string_view name;
+    std::uint64_t calls = 0;
+    std::chrono::nanoseconds wall {0};  // NB: inclusive of any phases nested inside
+    AllocStats allocs;                  // only counted in binaries that link AllocStats.cpp
+    std::uint64_t peak_rss_bytes = 0;   // process-wide high-water mark, as of the phase's last exit
+};
+
+// Off by default, in which case a Phase costs one relaxed load
+void enable_instrumentation(bool enabled);
+[[nodiscard]] bool instrumentation_enabled();
+
+// The calling thread's phases, in the order they were first entered
+[[nodiscard]] std::vector<PhaseStats> thread_phase_stats();
+void reset_thread_phase_stats();
+
+[[nodiscard]] std::uint64_t peak_rss_bytes();
+
+class Phase {
+    /// Adds the wall time and allocations between construction and destruction to the calling thread's
+    /// stats for `name`, eg. `const aoc::Phase phase {"q5 parse: Almanac"};`
+    /// NB: `name` is kept as a view, so it should be a string literal
+    std::string_view m_name;
+    bool m_is_active;
+    std::chrono::steady_clock::time_point m_start;
+    AllocStats m_allocs_at_start;
+
+public:
+    explicit Phase(std::string_view name);
+    ~Phase();
+
+    Phase(const Phase&) = delete;
+    Phase& operator=(const Phase&) = delete;
+};
+
+}
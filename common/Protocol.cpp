@@ -0,0 +1,141 @@
+#include "Protocol.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace aoc::protocol {
+
+namespace {
+
+sockaddr_un unix_address(std::string_view path) {
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof address.sun_path) {
+        throw std::runtime_error("Socket path too long");
+    }
+    std::memcpy(address.sun_path, path.data(), path.size());
+    return address;
+}
+
+void write_all(int fd, const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t written = send(fd, bytes, size, MSG_NOSIGNAL); // NB: a closed peer is an error, not a SIGPIPE
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Unable to write to socket");
+        }
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+bool read_all(int fd, void* data, std::size_t size) {
+    /// false if the peer closed the connection before sending anything; throws if it closed part way through
+    auto* bytes = static_cast<char*>(data);
+    std::size_t received = 0;
+    while (received < size) {
+        const ssize_t n = recv(fd, bytes + received, size - received, 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Unable to read from socket");
+        }
+        if (n == 0) {
+            if (received == 0) return false;
+            throw std::runtime_error("Connection closed mid-message");
+        }
+        received += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+void read_exactly(int fd, void* data, std::size_t size) {
+    if (size > 0 && !read_all(fd, data, size)) {
+        throw std::runtime_error("Connection closed mid-message");
+    }
+}
+
+}
+
+Socket& Socket::operator=(Socket&& other) noexcept {
+    if (this != &other) {
+        if (m_fd >= 0) close(m_fd);
+        m_fd = other.release();
+    }
+    return *this;
+}
+
+Socket::~Socket() {
+    if (m_fd >= 0) close(m_fd);
+}
+
+Socket listen_unix(std::string_view path) {
+    const sockaddr_un address = unix_address(path);
+    Socket socket {::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    if (socket.fd() < 0) {
+        throw std::runtime_error("Unable to create socket");
+    }
+    unlink(address.sun_path);
+    if (bind(socket.fd(), reinterpret_cast<const sockaddr*>(&address), sizeof address) != 0
+        || listen(socket.fd(), SOMAXCONN) != 0) {
+        throw std::runtime_error("Unable to listen on socket");
+    }
+    return socket;
+}
+
+Socket connect_unix(std::string_view path) {
+    const sockaddr_un address = unix_address(path);
+    Socket socket {::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    if (socket.fd() < 0) {
+        throw std::runtime_error("Unable to create socket");
+    }
+    if (connect(socket.fd(), reinterpret_cast<const sockaddr*>(&address), sizeof address) != 0) {
+        throw std::runtime_error("Unable to connect to socket");
+    }
+    return socket;
+}
+
+bool read_request(int fd, Request& request) {
+    RequestHeader header {};
+    if (!read_all(fd, &header, sizeof header)) {
+        return false;
+    }
+    if (header.magic != magic || header.input_size > max_input_size) {
+        throw std::runtime_error("Malformed request");
+    }
+    request.day = header.day;
+    request.part = header.part;
+    request.input.resize(header.input_size); // NB: keeps its capacity from earlier requests on this connection
+    read_exactly(fd, request.input.data(), request.input.size());
+    return true;
+}
+
+void write_request(int fd, int day, int part, std::string_view input) {
+    const RequestHeader header {magic, day, part, 0, input.size()};
+    write_all(fd, &header, sizeof header);
+    write_all(fd, input.data(), input.size());
+}
+
+Response read_response(int fd) {
+    ResponseHeader header {};
+    read_exactly(fd, &header, sizeof header);
+    if (header.magic != magic || header.message_size > max_input_size) {
+        throw std::runtime_error("Malformed response");
+    }
+    Response response {.is_error = header.is_error != 0, .answer = header.answer, .message = {}};
+    response.message.resize(header.message_size);
+    read_exactly(fd, response.message.data(), response.message.size());
+    return response;
+}
+
+void write_response(int fd, const Response& response) {
+    const ResponseHeader header {magic, response.is_error ? 1u : 0u, response.answer, response.message.size()};
+    write_all(fd, &header, sizeof header);
+    write_all(fd, response.message.data(), response.message.size());
+}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "Days.h"
+
+namespace aoc::protocol {
+
+// Wire format (host byte order, as both ends share a machine):
+//   request:  RequestHeader, then input_size bytes of puzzle input
+//   response: ResponseHeader, then message_size bytes of error message (empty on success)
+// A connection carries any number of request/response pairs, one at a time.
+
+inline constexpr std::uint32_t magic = 0x31434f41; // "AOC1"
+inline constexpr std::uint64_t max_input_size = std::uint64_t{1} << 30;
+
+struct RequestHeader {
+    std::uint32_t magic;
+    std::int32_t day;
+    std::int32_t part;
+    std::uint32_t reserved;
+    std::uint64_t input_size;
+};
+
+struct ResponseHeader {
+    std::uint32_t magic;
+    std::uint32_t is_error;
+    std::int64_t answer;
+    std::uint64_t message_size;
+};
+
+struct Request {
+    int day = 0;
+    int part = 0;
+    std::string input;
+};
+
+struct Response {
+    bool is_error = false;
+    Answer answer = 0;
+    std::string message;
+};
+
+class Socket {
+    /// Owns a file descriptor
+    int m_fd = -1;
+public:
+    Socket() = default;
+    explicit Socket(int fd) : m_fd{fd} { }
+    Socket(Socket&& other) noexcept : m_fd{other.release()} { }
+    Socket& operator=(Socket&& other) noexcept;
+    ~Socket();
+
+    [[nodiscard]] int fd() const { return m_fd; }
+    int release() { const int fd = m_fd; m_fd = -1; return fd; }
+};
+
+// Both throw std::runtime_error on failure. listen_unix replaces a stale socket file at `path`.
+[[nodiscard]] Socket listen_unix(std::string_view path);
+[[nodiscard]] Socket connect_unix(std::string_view path);
+
+// Reads the next request into `request`, reusing its buffer. Returns false if the peer closed the connection
+// cleanly between requests; throws std::runtime_error on a malformed or truncated one.
+bool read_request(int fd, Request& request);
+void write_request(int fd, int day, int part, std::string_view input);
+
+[[nodiscard]] Response read_response(int fd);
+void write_response(int fd, const Response& response);
+
+}
@@ -0,0 +1,103 @@
+#include "ResultCache.h"
+
+#include <array>
+#include <cstdio>
+#include <fmt/format.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Input.h"
+
+namespace aoc {
+
+namespace {
+
+constexpr std::string_view header_tag = "aoc-result-cache 1";
+
+}
+
+Hash128 build_key() {
+    struct stat info {};
+    if (stat("/proc/self/exe", &info) != 0) {
+        throw std::runtime_error("Unable to identify the running executable");
+    }
+    const std::array<std::uint64_t, 5> identity {
+        static_cast<std::uint64_t>(info.st_dev),
+        static_cast<std::uint64_t>(info.st_ino),
+        static_cast<std::uint64_t>(info.st_size),
+        static_cast<std::uint64_t>(info.st_mtim.tv_sec),
+        static_cast<std::uint64_t>(info.st_mtim.tv_nsec)
+    };
+    return hash128(std::string_view{reinterpret_cast<const char*>(identity.data()), sizeof identity});
+}
+
+ResultCache::ResultCache(std::string path, Hash128 build_key) : m_path{std::move(path)}, m_build_key{build_key} {
+    load();
+}
+
+void ResultCache::load() {
+    if (access(m_path.c_str(), F_OK) != 0) return; // no cache yet
+
+    try {
+        const MappedFile file(m_path);
+        std::string_view remaining = file.view();
+
+        const std::string expected_header = fmt::format("{} {}", header_tag, to_hex(m_build_key));
+        if (next_line(remaining) != expected_header) {
+            m_is_dirty = true; // another build's answers: overwrite them on save
+            return;
+        }
+
+        while (!remaining.empty()) {
+            std::istringstream fields {std::string(next_line(remaining))};
+            int day = 0, part = 0;
+            std::string hash;
+            Answer answer = 0;
+            if (!(fields >> day >> part >> hash >> answer)) {
+                throw std::runtime_error("Malformed result cache line");
+            }
+            m_answers[{day, part, hash128_from_hex(hash)}] = answer;
+        }
+    }
+    catch (const std::exception&) { // NB: a cache is only ever an optimisation; start again rather than fail
+        m_answers.clear();
+        m_is_dirty = true;
+    }
+}
+
+std::optional<Answer> ResultCache::find(int day, int part, Hash128 input_hash) const {
+    const auto it = m_answers.find({day, part, input_hash});
+    if (it == m_answers.end()) return std::nullopt;
+    return it->second;
+}
+
+void ResultCache::insert(int day, int part, Hash128 input_hash, Answer answer) {
+    m_answers[{day, part, input_hash}] = answer;
+    m_is_dirty = true;
+}
+
+void ResultCache::save() {
+    if (!m_is_dirty) return;
+
+    const std::string temp_path = fmt::format("{}.{}.tmp", m_path, getpid());
+    std::FILE* out = std::fopen(temp_path.c_str(), "w");
+    if (out == nullptr) {
+        throw std::runtime_error("Unable to open file");
+    }
+    fmt::print(out, "{} {}\n", header_tag, to_hex(m_build_key));
+    for (const auto& [key, answer] : m_answers) {
+        const auto& [day, part, hash] = key;
+        fmt::print(out, "{} {} {} {}\n", day, part, to_hex(hash), answer);
+    }
+    const bool is_written = std::fflush(out) == 0 && std::ferror(out) == 0;
+    std::fclose(out);
+    if (!is_written || std::rename(temp_path.c_str(), m_path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        throw std::runtime_error("Unable to write result cache");
+    }
+    m_is_dirty = false;
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+
+#include "Days.h"
+#include "Hash.h"
+
+namespace aoc {
+
+// Identifies the solver build: the running executable's identity (device, inode, size, modification time),
+// so a rebuilt binary never sees answers cached by an older one
+[[nodiscard]] Hash128 build_key();
+
+class ResultCache {
+    /// On-disk map of (day, part, input hash) -> answer, tied to one build.
+    /// File format: a header line "aoc-result-cache 1 <build key>", then one "<day> <part> <input hash> <answer>"
+    /// per line. A file written by another build, or one that can't be read, starts the cache afresh.
+    using Key = std::tuple<int, int, Hash128>;
+
+    std::string m_path;
+    Hash128 m_build_key;
+    std::map<Key, Answer> m_answers;
+    bool m_is_dirty = false;
+
+    void load();
+
+public:
+    ResultCache(std::string path, Hash128 build_key);
+
+    [[nodiscard]] std::optional<Answer> find(int day, int part, Hash128 input_hash) const;
+    void insert(int day, int part, Hash128 input_hash, Answer answer);
+
+    // Writes the cache back if anything was inserted; replaces the file atomically so readers never see half of it
+    void save();
+
+    [[nodiscard]] std::size_t size() const { return m_answers.size(); }
+};
+
+}
@@ -0,0 +1,106 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace aoc {
+
+namespace {
+
+thread_local const ThreadPool* t_pool = nullptr; // the pool the current thread works for, if any
+thread_local std::size_t t_worker_ix = 0;
+
+}
+
+ThreadPool::ThreadPool(std::size_t no_of_threads) {
+    no_of_threads = std::max<std::size_t>(no_of_threads, 1);
+    for (std::size_t i = 0; i < no_of_threads; ++i) {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 0; i < no_of_threads; ++i) {
+        m_workers.emplace_back([this, i](){ run_worker(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    /// Runs whatever is still queued, then joins the workers
+    {
+        const std::lock_guard lock {m_idle_mutex};
+        m_stopping = true;
+    }
+    m_idle.notify_all();
+    m_workers.clear();
+}
+
+void ThreadPool::push(Task task) {
+    const std::size_t queue_ix = (t_pool == this) ? t_worker_ix : m_next_queue++ % m_queues.size();
+    {
+        Queue& queue = *m_queues[queue_ix];
+        const std::lock_guard lock {queue.mutex};
+        queue.tasks.push_back(std::move(task));
+    }
+    /// NB: m_pending is raised before m_parked is read, and a parking worker raises m_parked before checking
+    /// m_pending, so either the worker sees the task or we see the worker (both seq_cst)
+    ++m_pending;
+    if (m_parked.load() > 0) {
+        { const std::lock_guard lock {m_idle_mutex}; } // NB: so the notify can't land between its check and its wait
+        m_idle.notify_one();
+    }
+}
+
+bool ThreadPool::try_claim() {
+    std::size_t pending = m_pending.load();
+    while (pending > 0) {
+        if (m_pending.compare_exchange_weak(pending, pending - 1)) return true;
+    }
+    return false;
+}
+
+bool ThreadPool::is_worker_thread() const {
+    return t_pool == this;
+}
+
+bool ThreadPool::try_pop(std::size_t worker_ix, Task& task) {
+    { // own work, newest first
+        Queue& own = *m_queues[worker_ix];
+        const std::lock_guard lock {own.mutex};
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (std::size_t i = 1; i < m_queues.size(); ++i) { // steal, oldest first
+        Queue& victim = *m_queues[(worker_ix + i) % m_queues.size()];
+        const std::lock_guard lock {victim.mutex};
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run_worker(std::size_t worker_ix) {
+    t_pool = this;
+    t_worker_ix = worker_ix;
+
+    while (true) {
+        if (!try_claim()) { // claims one task; it is already in some queue as it was pushed before being counted
+            std::unique_lock lock {m_idle_mutex};
+            ++m_parked;
+            m_idle.wait(lock, [&](){ return m_pending.load() > 0 || m_stopping; });
+            --m_parked;
+            if (m_pending.load() == 0) return; // stopping, and nothing left to run
+            continue;
+        }
+
+        Task task;
+        while (!try_pop(worker_ix, task)) {
+            std::this_thread::yield(); // NB: a scan can miss while others pop concurrently, but our task is still queued
+        }
+        task();
+    }
+}
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace aoc {
+
+class ThreadPool {
+    /// Work-stealing pool: each worker has its own deque, runs its newest task first and, when that runs dry,
+    /// steals the oldest task from another worker. Tasks submitted from outside are dealt round-robin; tasks
+    /// submitted from inside a task go to the submitting worker's own deque. A worker only parks on the condition
+    /// variable once there's nothing left to claim, and a push only takes the idle mutex to wake one when one is parked.
+    using Task = std::function<void()>;
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::jthread> m_workers;
+
+    std::atomic<std::size_t> m_pending = 0; // tasks pushed but not yet claimed by a worker
+    std::atomic<std::size_t> m_parked = 0; // workers waiting on m_idle, or about to
+    std::mutex m_idle_mutex;
+    std::condition_variable m_idle;
+    bool m_stopping = false; // guarded by m_idle_mutex
+
+    std::atomic<std::size_t> m_next_queue = 0;
+
+    void push(Task task);
+    bool try_claim();
+    bool try_pop(std::size_t worker_ix, Task& task);
+    void run_worker(std::size_t worker_ix);
+
+public:
+    explicit ThreadPool(std::size_t no_of_threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    [[nodiscard]] std::size_t size() const { return m_workers.size(); }
+
+    // Whether the calling thread is one of this pool's workers, ie. is running one of its tasks
+    [[nodiscard]] bool is_worker_thread() const;
+
+    template<typename F>
+    [[nodiscard]] std::future<std::invoke_result_t<F>> submit(F&& f) {
+        /// NB: exceptions thrown by `f` are rethrown from the future's get()
+        using Result = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f));
+        std::future<Result> result = task->get_future();
+        push([task](){ (*task)(); });
+        return result;
+    }
+};
+
+template<typename F>
+void parallel_for(ThreadPool* pool, std::size_t n, F&& f) {
+    /// Calls f(begin, end) over [0, n) in a few chunks per worker of `pool`, or once inline if `pool` is null.
+    /// NB: blocks until every chunk is done, so don't call it from inside one of `pool`'s own tasks: the blocked
+    /// worker can't run the chunks queued behind it, and with every worker blocked like that the pool deadlocks
+    assert((pool == nullptr || !pool->is_worker_thread()) && "parallel_for called from inside its own pool");
+    const std::size_t no_of_chunks = (pool == nullptr) ? 1 : std::min(pool->size() * 4, n);
+    if (no_of_chunks <= 1) {
+        if (n > 0) f(std::size_t{0}, n);
+        return;
+    }
+    std::vector<std::future<void>> chunks;
+    chunks.reserve(no_of_chunks);
+    for (std::size_t c = 0; c < no_of_chunks; ++c) {
+        const std::size_t begin = n * c / no_of_chunks;
+        const std::size_t end = n * (c + 1) / no_of_chunks;
+        chunks.push_back(pool->submit([&f, begin, end](){ f(begin, end); }));
+    }
+    for (auto& chunk : chunks) chunk.wait(); // NB: every chunk refers to `f`, so none may outlive this call
+    for (auto& chunk : chunks) chunk.get();
+}
+
+}
@@ -0,0 +1,710 @@
+#include "Generators.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fmt/format.h>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace aoc::gen {
+
+namespace {
+
+using Rows = std::vector<std::string>;
+
+std::size_t side_length(std::size_t base, unsigned scale) {
+    /// grid inputs grow in both directions, so `scale` times the bytes means sqrt(scale) times the side
+    return static_cast<std::size_t>(std::lround(static_cast<double>(base) * std::sqrt(static_cast<double>(scale))));
+}
+
+std::string join_rows(const Rows& rows) {
+    std::string out;
+    for (const auto& row : rows) {
+        out += row;
+        out += '\n';
+    }
+    return out;
+}
+
+bool is_prime(std::uint64_t n) {
+    if (n < 2) return false;
+    for (std::uint64_t d = 2; d * d <= n; ++d) {
+        if (n % d == 0) return false;
+    }
+    return true;
+}
+
+std::uint64_t next_prime(std::uint64_t n) {
+    /// smallest prime >= n
+    while (!is_prime(n)) ++n;
+    return n;
+}
+
+template<typename Range>
+std::string join(const Range& items, std::string_view separator) {
+    std::string out;
+    for (const auto& item : items) {
+        if (!out.empty()) out += separator;
+        fmt::format_to(std::back_inserter(out), "{}", item);
+    }
+    return out;
+}
+
+// q1: calibration lines, letters mixed with digits and (sometimes overlapping) number words
+
+std::string calibration_document(Rng& rng, unsigned scale) {
+    static constexpr std::array<std::string_view, 9> words {"one", "two", "three", "four", "five", "six", "seven", "eight", "nine"};
+
+    std::string out;
+    for (std::size_t n = 0; n < 1000 * std::size_t{scale}; ++n) {
+        std::string line;
+        const auto pieces = rng.between(2, 8);
+        for (std::int64_t p = 0; p < pieces; ++p) {
+            switch (rng.below(3)) {
+                case 0: {
+                    const auto run = rng.between(1, 5);
+                    for (std::int64_t i = 0; i < run; ++i) {
+                        line += static_cast<char>('a' + rng.below(26));
+                    }
+                    break;
+                }
+                case 1: {
+                    line += static_cast<char>('1' + rng.below(9));
+                    break;
+                }
+                default: {
+                    const std::string_view word = rng.pick(words);
+                    const bool overlaps = !line.empty() && line.back() == word.front(); // eg. "twone", "eightwo"
+                    line += word.substr(overlaps ? 1 : 0);
+                    break;
+                }
+            }
+        }
+        if (std::ranges::none_of(line, [](char c){ return '1' <= c && c <= '9'; })) { // part 1 needs a digit on every line
+            line.insert(line.begin() + static_cast<long>(rng.below(line.size() + 1)), static_cast<char>('1' + rng.below(9)));
+        }
+        out += line;
+        out += '\n';
+    }
+    return out;
+}
+
+// q2: game records
+
+std::string game_records(Rng& rng, unsigned scale) {
+    std::array<std::string_view, 3> colours {"red", "green", "blue"};
+
+    std::string out;
+    for (std::size_t game = 1; game <= 100 * std::size_t{scale}; ++game) {
+        std::vector<std::string> draws;
+        const auto no_of_draws = rng.between(1, 6);
+        for (std::int64_t d = 0; d < no_of_draws; ++d) {
+            rng.shuffle(colours);
+            const auto no_of_colours = rng.between(1, 3);
+            std::vector<std::string> cubes;
+            for (std::int64_t c = 0; c < no_of_colours; ++c) {
+                cubes.push_back(fmt::format("{} {}", rng.between(1, 20), colours[c]));
+            }
+            draws.push_back(join(cubes, ", "));
+        }
+        fmt::format_to(std::back_inserter(out), "Game {}: {}\n", game, join(draws, "; "));
+    }
+    return out;
+}
+
+// q3: engine schematic
+
+struct PartNumber {
+    std::size_t row, first_col, last_col;
+};
+
+std::vector<PartNumber> find_numbers(const Rows& rows) {
+    std::vector<PartNumber> numbers;
+    for (std::size_t row = 0; row < rows.size(); ++row) {
+        const auto& line = rows[row];
+        for (std::size_t col = 0; col < line.size(); ++col) {
+            if (!std::isdigit(line[col])) continue;
+            const std::size_t first = col;
+            while (col + 1 < line.size() && std::isdigit(line[col + 1])) ++col;
+            numbers.push_back({row, first, col});
+        }
+    }
+    return numbers;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> adjacent_gears(const Rows& rows, const PartNumber& number) {
+    std::vector<std::pair<std::size_t, std::size_t>> gears;
+    const std::size_t first_row = (number.row == 0) ? 0 : number.row - 1;
+    const std::size_t last_row = std::min(number.row + 1, rows.size() - 1);
+    const std::size_t first_col = (number.first_col == 0) ? 0 : number.first_col - 1;
+    const std::size_t last_col = std::min(number.last_col + 1, rows[0].size() - 1);
+    for (std::size_t row = first_row; row <= last_row; ++row) {
+        for (std::size_t col = first_col; col <= last_col; ++col) {
+            if (rows[row][col] == '*') gears.emplace_back(row, col);
+        }
+    }
+    return gears;
+}
+
+std::string engine_schematic(Rng& rng, unsigned scale) {
+    static constexpr std::string_view other_symbols = "#+$/@%=&-";
+
+    const std::size_t side = side_length(140, scale);
+    auto symbol = [&]() { return rng.chance(0.4) ? '*' : rng.pick(other_symbols); };
+
+    Rows rows(side, std::string(side, '.'));
+    for (auto& line : rows) {
+        std::size_t col = 0;
+        while (col < side) {
+            if (rng.chance(0.12)) {
+                const auto length = std::min<std::size_t>(rng.between(1, 3), side - col);
+                line[col++] = static_cast<char>('1' + rng.below(9)); // NB: no leading zeros
+                for (std::size_t i = 1; i < length; ++i) {
+                    line[col++] = static_cast<char>('0' + rng.below(10));
+                }
+                if (col < side) { // never two numbers back to back
+                    line[col++] = rng.chance(0.1) ? symbol() : '.';
+                }
+            }
+            else {
+                line[col++] = rng.chance(0.06) ? symbol() : '.';
+            }
+        }
+    }
+
+    // Keep to the well-formed cases: a gear touches at most two numbers, and a number at most one gear
+    const std::vector<PartNumber> numbers = find_numbers(rows);
+    std::map<std::pair<std::size_t, std::size_t>, unsigned> numbers_per_gear;
+    for (const auto& number : numbers) {
+        for (const auto& gear : adjacent_gears(rows, number)) {
+            ++numbers_per_gear[gear];
+        }
+    }
+    for (const auto& [gear, count] : numbers_per_gear) {
+        if (count > 2) rows[gear.first][gear.second] = '#';
+    }
+    for (const auto& number : numbers) {
+        const auto gears = adjacent_gears(rows, number);
+        for (std::size_t i = 1; i < gears.size(); ++i) {
+            rows[gears[i].first][gears[i].second] = '+';
+        }
+    }
+
+    return join_rows(rows);
+}
+
+// q4: scratchcards
+
+std::string scratchcards(Rng& rng, unsigned scale, std::size_t no_of_winning, std::size_t no_of_yours, int max_number) {
+    /// Cards come in blocks of ten, and a card's matches never reach past the end of its block, so the number of
+    /// copies in part 2 stays bounded however many cards there are.
+    /// NB: each side's numbers are distinct, drawn from 1 to max_number, which must leave room for both sides
+    constexpr std::size_t block_size = 10;
+    const std::size_t no_of_cards = 200 * std::size_t{scale};
+    const auto id_width = std::to_string(no_of_cards).size();
+    const auto number_width = std::to_string(max_number).size();
+
+    std::vector<int> numbers(static_cast<std::size_t>(max_number));
+    std::iota(begin(numbers), end(numbers), 1);
+    const auto first_yours = begin(numbers) + static_cast<long>(no_of_winning);
+
+    std::string out;
+    for (std::size_t card = 0; card < no_of_cards; ++card) {
+        const auto max_matches = static_cast<std::int64_t>(std::min(block_size - 1 - card % block_size, no_of_cards - 1 - card));
+        const auto matches = (max_matches == 0 || rng.chance(0.5)) ? 0 : rng.between(1, max_matches);
+
+        rng.shuffle(numbers);
+        const std::vector<int> winning (begin(numbers), first_yours);
+        std::vector<int> yours (begin(numbers), begin(numbers) + matches);
+        yours.insert(end(yours), first_yours, first_yours + (static_cast<std::int64_t>(no_of_yours) - matches));
+        rng.shuffle(yours);
+
+        fmt::format_to(std::back_inserter(out), "Card {:>{}}: ", card + 1, id_width);
+        for (const int n : winning) fmt::format_to(std::back_inserter(out), "{:>{}} ", n, number_width);
+        out += '|';
+        for (const int n : yours) fmt::format_to(std::back_inserter(out), " {:>{}}", n, number_width);
+        out += '\n';
+    }
+    return out;
+}
+
+// q5: almanac
+
+std::vector<std::uint64_t> distinct_sorted(Rng& rng, std::size_t count, std::uint64_t limit) {
+    std::set<std::uint64_t> values;
+    while (values.size() < count) {
+        values.insert(rng.below(limit));
+    }
+    return {begin(values), end(values)};
+}
+
+std::string almanac(Rng& rng, unsigned scale) {
+    /// Each map cuts a span of [0, 2^32) into chunks and lays them back down in a shuffled order, so it is a
+    /// bijection like the real maps. Seed ranges don't overlap.
+    static constexpr std::array<std::string_view, 7> names {
+        "seed-to-soil", "soil-to-fertilizer", "fertilizer-to-water", "water-to-light",
+        "light-to-temperature", "temperature-to-humidity", "humidity-to-location"
+    };
+    constexpr std::uint64_t limit = std::uint64_t{1} << 32;
+
+    const std::size_t no_of_seed_ranges = 10 * std::size_t{scale};
+    const auto seed_cuts = distinct_sorted(rng, 2 * no_of_seed_ranges, limit);
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> seed_ranges; // start, length
+    for (std::size_t i = 0; i < seed_cuts.size(); i += 2) {
+        seed_ranges.emplace_back(seed_cuts[i], seed_cuts[i + 1] - seed_cuts[i]);
+    }
+    rng.shuffle(seed_ranges);
+
+    std::string out = "seeds:";
+    for (const auto& [start, length] : seed_ranges) {
+        fmt::format_to(std::back_inserter(out), " {} {}", start, length);
+    }
+    out += '\n';
+
+    const std::size_t no_of_chunks = 30 * std::size_t{scale};
+    for (const auto name : names) {
+        const auto cuts = distinct_sorted(rng, no_of_chunks + 1, limit);
+        std::vector<std::size_t> order(no_of_chunks);
+        std::iota(begin(order), end(order), 0);
+        rng.shuffle(order);
+
+        std::vector<std::string> entries;
+        std::uint64_t destination = cuts.front();
+        for (const auto chunk : order) {
+            const std::uint64_t length = cuts[chunk + 1] - cuts[chunk];
+            entries.push_back(fmt::format("{} {} {}", destination, cuts[chunk], length));
+            destination += length;
+        }
+        rng.shuffle(entries);
+
+        fmt::format_to(std::back_inserter(out), "\n{} map:\n", name);
+        for (const auto& entry : entries) {
+            out += entry;
+            out += '\n';
+        }
+    }
+    return out;
+}
+
+// q6: race records
+
+std::string race_records(Rng& rng, [[maybe_unused]] unsigned scale) {
+    /// NB: always four races; part 2 concatenates them into a single `long`, so the input can't grow
+    std::array<std::int64_t, 4> times {};
+    std::array<std::int64_t, 4> records {};
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        times[i] = rng.between(40, 99);
+        const auto best = (times[i] / 2) * (times[i] - times[i] / 2);
+        records[i] = rng.between(best / 2, best - 1);
+    }
+    return fmt::format("Time:      {}\nDistance:  {}\n", join(times, "    "), join(records, "  "));
+}
+
+// q7: camel card hands
+
+std::string camel_card_hands(Rng& rng, unsigned scale) {
+    /// A repeated hand always gets the same bid, so ties in the ranking can't change the answer
+    static constexpr std::string_view cards = "23456789TJQKA";
+    const std::uint64_t salt = rng.next();
+
+    std::string out;
+    for (std::size_t n = 0; n < 1000 * std::size_t{scale}; ++n) {
+        std::string hand;
+        for (int i = 0; i < 5; ++i) hand += rng.pick(cards);
+
+        std::uint64_t hash = salt; // FNV-1a
+        for (const char c : hand) hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+        fmt::format_to(std::back_inserter(out), "{} {}\n", hand, 1 + (hash >> 33) % 1000);
+    }
+    return out;
+}
+
+// q8: desert network
+
+std::string desert_network(Rng& rng, unsigned scale) {
+    /// Six ghosts, each on its own chain of k * L steps from its ..A node to its ..Z node, where L is the length of
+    /// the instruction string and the k are distinct primes; a ..Z node leads where its ..A node does. Every node
+    /// points the way the instructions say at the step it is reached, and its other exit somewhere random.
+    /// Part 1 follows AAA -> ZZZ (k0 * L steps), part 2 is L * k0 * ... * k5.
+    /// Node names are three characters, so the network stops growing at about 40k nodes.
+    constexpr std::size_t no_of_ghosts = 6;
+    const std::size_t steps_per_ghost = std::min<std::size_t>(120 * std::size_t{scale}, 6500);
+
+    const std::uint64_t instruction_length = next_prime(static_cast<std::uint64_t>(std::sqrt(static_cast<double>(steps_per_ghost))));
+    std::vector<std::uint64_t> cycles;
+    for (std::uint64_t k = next_prime(steps_per_ghost / instruction_length); cycles.size() < no_of_ghosts; k = next_prime(k + 1)) {
+        if (k != instruction_length) cycles.push_back(k);
+    }
+    rng.shuffle(cycles);
+
+    std::string instructions;
+    for (std::uint64_t i = 0; i < instruction_length; ++i) {
+        instructions += rng.chance(0.5) ? 'L' : 'R';
+    }
+
+    static constexpr std::string_view alphabet = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    std::vector<std::string> inner_names;
+    std::vector<std::string> prefixes;
+    for (const char a : alphabet) {
+        for (const char b : alphabet) {
+            if (a != 'A' || b != 'A') prefixes.push_back({a, b});
+            for (const char c : alphabet) {
+                if (c != 'A' && c != 'Z') inner_names.push_back({a, b, c});
+            }
+        }
+    }
+    rng.shuffle(inner_names);
+    rng.shuffle(prefixes);
+
+    struct Node {
+        std::string name;
+        std::size_t left, right;
+    };
+    constexpr std::size_t unlinked = std::numeric_limits<std::size_t>::max();
+    std::vector<Node> nodes;
+    std::size_t next_inner_name = 0;
+
+    for (std::size_t ghost = 0; ghost < no_of_ghosts; ++ghost) {
+        const std::size_t chain_length = cycles[ghost] * instruction_length;
+        const std::size_t first = nodes.size(); // chain: first (..A), first + 1 ... first + chain_length - 1, then ..Z
+        const std::string prefix = (ghost == 0) ? "AA" : prefixes[ghost];
+        const std::string end_prefix = (ghost == 0) ? "ZZ" : prefixes[ghost];
+
+        nodes.push_back({prefix + 'A', unlinked, unlinked});
+        for (std::size_t i = 1; i < chain_length; ++i) {
+            nodes.push_back({inner_names[next_inner_name++], unlinked, unlinked});
+        }
+        nodes.push_back({end_prefix + 'Z', unlinked, unlinked});
+
+        auto link = [&](std::size_t from, std::size_t step, std::size_t to) {
+            const bool goes_left = instructions[step % instruction_length] == 'L';
+            (goes_left ? nodes[from].left : nodes[from].right) = to;
+        };
+        for (std::size_t i = 0; i < chain_length; ++i) {
+            link(first + i, i, first + i + 1);
+        }
+        link(first + chain_length, 0, first + 1); // ..Z carries on like ..A
+    }
+
+    for (auto& node : nodes) { // the way the instructions never go
+        for (auto* exit : {&node.left, &node.right}) {
+            if (*exit == unlinked) *exit = rng.below(nodes.size());
+        }
+    }
+
+    std::vector<std::string> lines;
+    for (const auto& node : nodes) {
+        lines.push_back(fmt::format("{} = ({}, {})", node.name, nodes[node.left].name, nodes[node.right].name));
+    }
+    rng.shuffle(lines);
+
+    return instructions + "\n\n" + join_rows(lines);
+}
+
+// q9: OASIS sequences
+
+std::string oasis_report(Rng& rng, unsigned scale) {
+    /// Each line is 21 values of a polynomial of degree <= 6, built up from a constant row of differences
+    std::string out;
+    for (std::size_t n = 0; n < 200 * std::size_t{scale}; ++n) {
+        const auto degree = rng.between(0, 6);
+        std::vector<std::int64_t> values(21, rng.between(-3, 3));
+        for (std::int64_t level = 0; level < degree; ++level) {
+            std::int64_t running = rng.between(-20, 20);
+            for (auto& v : values) {
+                const auto difference = v;
+                v = running;
+                running += difference;
+            }
+        }
+        out += join(values, " ");
+        out += '\n';
+    }
+    return out;
+}
+
+// q10: pipe maze
+
+std::string pipe_maze(Rng& rng, unsigned scale) {
+    /// The loop is the outline of a random tree drawn at triple resolution (a node is a 2x2 block of cells, an
+    /// edge a 2x1 bridge between them): a tree has no holes and the drawing has no pinch points, so its outline is
+    /// a single closed loop with ground inside it. Tiles off the loop are ground or stray pipe, except around S.
+    const std::size_t tree_side = side_length(47, scale);
+    const std::size_t cells = 3 * tree_side - 1;
+    const std::size_t side = cells + 1; // the outline runs along cell corners
+
+    std::vector<char> is_filled(cells * cells, 0);
+    auto filled = [&](std::ptrdiff_t row, std::ptrdiff_t col) -> bool {
+        const auto n = static_cast<std::ptrdiff_t>(cells);
+        return 0 <= row && row < n && 0 <= col && col < n && is_filled[static_cast<std::size_t>(row * n + col)];
+    };
+    auto fill_block = [&](std::size_t row, std::size_t col, std::size_t height, std::size_t width) {
+        for (std::size_t r = row; r < row + height; ++r) {
+            for (std::size_t c = col; c < col + width; ++c) {
+                is_filled[r * cells + c] = 1;
+            }
+        }
+    };
+
+    { // randomised depth-first tree over ~60% of the nodes
+        const std::size_t target = tree_side * tree_side * 3 / 5;
+        std::size_t visited_count = 1;
+        std::vector<char> visited(tree_side * tree_side, 0);
+        std::vector<std::pair<std::size_t, std::size_t>> stack {{0, 0}};
+        visited[0] = 1;
+        fill_block(0, 0, 2, 2);
+        while (!stack.empty() && visited_count < target) {
+            const auto [row, col] = stack.back();
+            std::vector<std::pair<std::size_t, std::size_t>> options;
+            if (row > 0 && !visited[(row - 1) * tree_side + col]) options.emplace_back(row - 1, col);
+            if (row + 1 < tree_side && !visited[(row + 1) * tree_side + col]) options.emplace_back(row + 1, col);
+            if (col > 0 && !visited[row * tree_side + col - 1]) options.emplace_back(row, col - 1);
+            if (col + 1 < tree_side && !visited[row * tree_side + col + 1]) options.emplace_back(row, col + 1);
+            if (options.empty()) {
+                stack.pop_back();
+                continue;
+            }
+            const auto [next_row, next_col] = rng.pick(options);
+            visited[next_row * tree_side + next_col] = 1;
+            ++visited_count;
+            fill_block(3 * next_row, 3 * next_col, 2, 2);
+            if (next_row != row) fill_block(3 * std::min(row, next_row) + 2, 3 * col, 1, 2);
+            else fill_block(3 * row, 3 * std::min(col, next_col) + 2, 2, 1);
+            stack.emplace_back(next_row, next_col);
+        }
+    }
+
+    Rows rows(side, std::string(side, '.'));
+    std::vector<std::pair<std::size_t, std::size_t>> loop;
+    for (std::size_t row = 0; row < side; ++row) {
+        for (std::size_t col = 0; col < side; ++col) {
+            const auto r = static_cast<std::ptrdiff_t>(row);
+            const auto c = static_cast<std::ptrdiff_t>(col);
+            // corner (r, c) touches cells (r-1, c-1), (r-1, c), (r, c-1), (r, c); an edge out of it is on the
+            // outline when exactly one of the two cells it separates is filled
+            const bool up = filled(r - 1, c - 1) != filled(r - 1, c);
+            const bool down = filled(r, c - 1) != filled(r, c);
+            const bool left = filled(r - 1, c - 1) != filled(r, c - 1);
+            const bool right = filled(r - 1, c) != filled(r, c);
+            char& tile = rows[row][col];
+            if (up && down) tile = '|';
+            else if (left && right) tile = '-';
+            else if (up && right) tile = 'L';
+            else if (up && left) tile = 'J';
+            else if (down && right) tile = 'F';
+            else if (down && left) tile = '7';
+            else continue;
+            loop.emplace_back(row, col);
+        }
+    }
+
+    static constexpr std::string_view pipes = "|-LJF7";
+    std::vector<char> on_loop(side * side, 0);
+    for (const auto& [row, col] : loop) on_loop[row * side + col] = 1;
+    for (std::size_t row = 0; row < side; ++row) {
+        for (std::size_t col = 0; col < side; ++col) {
+            if (!on_loop[row * side + col] && rng.chance(0.3)) rows[row][col] = rng.pick(pipes);
+        }
+    }
+
+    const auto [s_row, s_col] = rng.pick(loop);
+    rows[s_row][s_col] = 'S';
+    for (const auto& [dr, dc] : {std::pair{-1, 0}, std::pair{1, 0}, std::pair{0, -1}, std::pair{0, 1}}) {
+        const auto row = static_cast<std::ptrdiff_t>(s_row) + dr;
+        const auto col = static_cast<std::ptrdiff_t>(s_col) + dc;
+        const auto n = static_cast<std::ptrdiff_t>(side);
+        if (0 <= row && row < n && 0 <= col && col < n && !on_loop[static_cast<std::size_t>(row * n + col)]) {
+            rows[static_cast<std::size_t>(row)][static_cast<std::size_t>(col)] = '.';
+        }
+    }
+
+    return join_rows(rows);
+}
+
+// q11: galaxy image
+
+std::string galaxy_image(Rng& rng, unsigned scale) {
+    const std::size_t side = side_length(140, scale);
+    std::vector<char> empty_row(side), empty_col(side);
+    for (auto& e : empty_row) e = rng.chance(0.05);
+    for (auto& e : empty_col) e = rng.chance(0.05);
+
+    Rows rows(side, std::string(side, '.'));
+    for (std::size_t row = 0; row < side; ++row) {
+        for (std::size_t col = 0; col < side; ++col) {
+            if (!empty_row[row] && !empty_col[col] && rng.chance(0.025)) rows[row][col] = '#';
+        }
+    }
+    return join_rows(rows);
+}
+
+// q13: mirror patterns
+
+Rows transposed(const Rows& rows) {
+    Rows out(rows.front().size(), std::string(rows.size(), '.'));
+    for (std::size_t row = 0; row < rows.size(); ++row) {
+        for (std::size_t col = 0; col < rows[row].size(); ++col) {
+            out[col][row] = rows[row][col];
+        }
+    }
+    return out;
+}
+
+std::size_t mismatches_about(const Rows& rows, std::size_t line) {
+    /// cells that differ from their image in a horizontal mirror with `line` rows above it
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < std::min(line, rows.size() - line); ++i) {
+        const auto& above = rows[line - 1 - i];
+        const auto& below = rows[line + i];
+        for (std::size_t col = 0; col < above.size(); ++col) {
+            mismatches += (above[col] != below[col]);
+        }
+    }
+    return mismatches;
+}
+
+bool has_one_clean_and_one_smudged_line(const Rows& rows) {
+    /// the puzzle's promise: exactly one line reflects the pattern as it is, and exactly one more once a single
+    /// cell is flipped
+    std::size_t clean = 0;
+    std::size_t smudged = 0;
+    for (const Rows& oriented : {rows, transposed(rows)}) {
+        for (std::size_t line = 1; line < oriented.size(); ++line) {
+            const std::size_t mismatches = mismatches_about(oriented, line);
+            clean += (mismatches == 0);
+            smudged += (mismatches == 1);
+        }
+    }
+    return clean == 1 && smudged == 1;
+}
+
+std::string mirror_patterns(Rng& rng, unsigned scale) {
+    /// Each pattern reflects cleanly about a horizontal line and, but for one smudged cell, about a vertical one;
+    /// transposing half of them swaps which is which. Patterns that reflect about any other line, by chance, are
+    /// drawn again.
+    std::vector<std::string> patterns;
+    while (patterns.size() < 100 * std::size_t{scale}) {
+        const auto height = static_cast<std::size_t>(rng.between(5, 17));
+        const auto width = static_cast<std::size_t>(rng.between(5, 17));
+
+        // the clean line is off-centre, leaving rows outside its mirror for the smudge
+        auto line = static_cast<std::size_t>(rng.between(1, static_cast<std::int64_t>(height) - 1)); // rows above it
+        if (2 * line == height) ++line;
+        const auto smudged_line = static_cast<std::size_t>(rng.between(1, static_cast<std::int64_t>(width) - 1)); // cols left of it
+
+        // fill each row symmetric about the smudged line, then copy rows into their images in the clean one
+        Rows rows(height, std::string(width, '.'));
+        for (std::size_t row = 0; row < height; ++row) {
+            if (row >= line && row - line < line) {
+                rows[row] = rows[2 * line - 1 - row];
+                continue;
+            }
+            for (std::size_t col = 0; col < width; ++col) {
+                const bool is_mirrored = col >= smudged_line && col - smudged_line < smudged_line;
+                rows[row][col] = is_mirrored ? rows[row][2 * smudged_line - 1 - col] : (rng.chance(0.5) ? '#' : '.');
+            }
+        }
+
+        // NB: a row with no image in the clean line keeps that line clean; a column with one makes the smudge count
+        const std::size_t mirrored_rows = std::min(line, height - line);
+        const std::size_t mirrored_cols = std::min(smudged_line, width - smudged_line);
+        const std::size_t unmirrored_rows = height - 2 * mirrored_rows;
+        std::size_t smudge_row = rng.below(unmirrored_rows);
+        if (line < height - line) smudge_row += 2 * mirrored_rows; // NB: the unmirrored rows are below the mirror
+        auto& smudge = rows[smudge_row][smudged_line - mirrored_cols + rng.below(2 * mirrored_cols)];
+        smudge = (smudge == '#') ? '.' : '#';
+
+        if (!has_one_clean_and_one_smudged_line(rows)) continue;
+        patterns.push_back(join_rows(rng.chance(0.5) ? rows : transposed(rows)));
+    }
+    return join(patterns, "\n");
+}
+
+// q14: rock platform
+
+std::string rock_platform(Rng& rng, unsigned scale) {
+    const std::size_t side = side_length(100, scale);
+    Rows rows(side, std::string(side, '.'));
+    for (auto& row : rows) {
+        for (auto& c : row) {
+            const auto r = rng.below(100);
+            c = (r < 20) ? 'O' : (r < 35) ? '#' : '.';
+        }
+    }
+    return join_rows(rows);
+}
+
+// q15: initialization sequence
+
+std::string initialization_sequence(Rng& rng, unsigned scale) {
+    /// NB: no trailing newline; the solver would read it as part of the last step
+    std::vector<std::string> labels(500 * std::size_t{scale});
+    for (auto& label : labels) {
+        const auto length = rng.between(2, 6);
+        for (std::int64_t i = 0; i < length; ++i) label += static_cast<char>('a' + rng.below(26));
+    }
+
+    std::vector<std::string> steps;
+    for (std::size_t n = 0; n < 4000 * std::size_t{scale}; ++n) {
+        const std::string& label = rng.pick(labels);
+        steps.push_back(rng.chance(0.6) ? fmt::format("{}={}", label, rng.between(1, 9)) : label + '-');
+    }
+    return join(steps, ",");
+}
+
+// q16: contraption
+
+std::string contraption(Rng& rng, unsigned scale) {
+    /// NB: square, as the solver's part 2 assumes
+    static constexpr std::string_view devices = "/\\|-";
+    const std::size_t side = side_length(110, scale);
+    Rows rows(side, std::string(side, '.'));
+    for (auto& row : rows) {
+        for (auto& c : row) {
+            if (rng.chance(0.1)) c = rng.pick(devices);
+        }
+    }
+    return join_rows(rows);
+}
+
+}
+
+std::string generate_wide_scratchcards(unsigned scale, std::uint64_t seed) {
+    Rng rng {seed ^ (std::uint64_t{4} << 32)};
+    return scratchcards(rng, scale, 200, 300, 999);
+}
+
+bool has_generator(int day) {
+    return (1 <= day && day <= 11) || (13 <= day && day <= 16);
+}
+
+std::string generate(int day, unsigned scale, std::uint64_t seed) {
+    Rng rng {seed ^ (static_cast<std::uint64_t>(day) << 32)};
+    switch (day) {
+        case 1: return calibration_document(rng, scale);
+        case 2: return game_records(rng, scale);
+        case 3: return engine_schematic(rng, scale);
+        case 4: return scratchcards(rng, scale, 10, 25, 99);
+        case 5: return almanac(rng, scale);
+        case 6: return race_records(rng, scale);
+        case 7: return camel_card_hands(rng, scale);
+        case 8: return desert_network(rng, scale);
+        case 9: return oasis_report(rng, scale);
+        case 10: return pipe_maze(rng, scale);
+        case 11: return galaxy_image(rng, scale);
+        case 13: return mirror_patterns(rng, scale);
+        case 14: return rock_platform(rng, scale);
+        case 15: return initialization_sequence(rng, scale);
+        case 16: return contraption(rng, scale);
+        default: throw std::out_of_range("No generator for that day");
+    }
+}
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+
+namespace aoc::gen {
+
+class Rng {
+    /// splitmix64, with our own bounded draws rather than the std distributions (whose output differs between
+    /// standard libraries) so that a seed produces the same input everywhere.
+    std::uint64_t m_state;
+
+public:
+    explicit Rng(std::uint64_t seed) : m_state{seed} { }
+
+    std::uint64_t next() {
+        std::uint64_t z = (m_state += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t below(std::uint64_t n) { // [0, n)
+        return static_cast<std::uint64_t>((static_cast<unsigned __int128>(next()) * n) >> 64);
+    }
+    std::int64_t between(std::int64_t lo, std::int64_t hi) { // [lo, hi]
+        return lo + static_cast<std::int64_t>(below(static_cast<std::uint64_t>(hi - lo) + 1));
+    }
+    bool chance(double p) {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53 < p;
+    }
+
+    template<typename Range>
+    const auto& pick(const Range& options) {
+        return options[below(std::size(options))];
+    }
+
+    template<typename Range>
+    void shuffle(Range& range) {
+        for (std::size_t i = std::size(range); i > 1; --i) {
+            using std::swap;
+            swap(range[i - 1], range[below(i)]);
+        }
+    }
+};
+
+// Whether `generate` knows the input format of `day`.
+[[nodiscard]] bool has_generator(int day);
+
+// A valid puzzle input for `day`, roughly `scale` times the size of a real one. The same (day, scale, seed)
+// always gives the same bytes. Throws std::out_of_range for a day without a generator.
+[[nodiscard]] std::string generate(int day, unsigned scale, std::uint64_t seed);
+
+// Like generate(4, ...), but 200 winning numbers and 300 of yours a card, up to 999, rather than 10 and 25 up to 99
+[[nodiscard]] std::string generate_wide_scratchcards(unsigned scale, std::uint64_t seed);
+
+}
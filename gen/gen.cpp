@@ -0,0 +1,41 @@
+// Writes a synthetic puzzle input to stdout.
+//
+// Build: gen/*.cpp
+// Usage: gen <day> [--scale <n>] [--seed <n>]
+
+#include <cstdio>
+#include <fmt/format.h>
+#include <string>
+#include <string_view>
+
+#include "Generators.h"
+
+int main(int argc, char** argv) {
+
+    int day = 0;
+    unsigned scale = 1;
+    std::uint64_t seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--scale" && has_value) {
+            scale = static_cast<unsigned>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--seed" && has_value) {
+            seed = std::stoull(argv[++i]);
+        }
+        else {
+            day = std::stoi(std::string(arg));
+        }
+    }
+
+    if (!aoc::gen::has_generator(day)) {
+        fmt::print(stderr, "Usage: gen <day> [--scale <n>] [--seed <n>]\n");
+        return 1;
+    }
+
+    const std::string input = aoc::gen::generate(day, scale, seed);
+    std::fwrite(input.data(), 1, input.size(), stdout);
+    return 0;
+}
@@ -1,138 +1,331 @@
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <cstdint>
 #include <fmt/format.h>
-#include <fstream>
 #include <gsl/gsl>
 #include <iostream>
-#include <map>
 #include <numeric>
-#include <string>
+#include <string_view>
+#include <vector>
 
-const std::map<std::string, int> word_to_int = {{"one", 1}, {"two", 2}, {"three", 3}, {"four", 4}, {"five", 5}, {"six", 6}, {"seven", 7}, {"eight", 8}, {"nine", 9}};
-const std::vector<std::string> number_words = {"one", "two", "three", "four", "five", "six", "seven", "eight", "nine"};
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
-struct Info {
-    std::string::const_iterator pos;
-    int val = -1;
-};
+#include "common/Days.h"
+#include "common/Input.h"
+#include "common/Instrument.h"
+#include "common/ThreadPool.h"
 
-// ... digit_info()
+namespace q1 {
 
-template <typename Compare>
-Info n_most_digit_info(const std::string& row, Compare comp) {
-    /// std::less<>() for leftmost, std::greater<>() for rightmost
+constexpr std::array<std::string_view, 9> number_words = {"one", "two", "three", "four", "five", "six", "seven", "eight", "nine"};
 
-    auto max_digit = cend(row);
+struct Automaton {
+    /// Aho-Corasick over the digits and number_words, with the failure links folded into the transition table so
+    /// matching is one table lookup per character. Entering a state with value >= 0 means a digit or word (valued
+    /// 0 to 9) has just ended there. Built at compile time, see make_automaton()
+    static constexpr std::size_t max_states = 64;
+    std::array<std::array<std::uint8_t, 256>, max_states> next {}; // NB: indexed by byte, not by character class, to
+                                                                   // keep a single load on the critical path
+    std::array<std::int8_t, max_states> value {};
 
-    for (auto it = begin(row); it != end(row); ++it) {
-        if (std::isdigit(*it, std::locale()) && (max_digit == row.end() || comp(it, max_digit))) {
-            max_digit = it;
-        }
+    [[nodiscard]] constexpr std::uint8_t step(std::uint8_t state, char c) const {
+        return next[state][static_cast<unsigned char>(c)];
     }
+};
+
+constexpr Automaton make_automaton(bool is_reversed) {
+    /// The trie and its failure links are worked out over character classes (the few characters that appear in a
+    /// key, plus 0 for the rest) and only expanded to whole bytes at the end.
+    /// `is_reversed` spells every word backwards, for matching while reading a row from its end
+    constexpr std::size_t max_classes = 32;
+    Automaton a;
+    std::array<std::uint8_t, 256> class_of {};
+    std::size_t no_of_classes = 1;
+    std::size_t no_of_states = 1; // the root, state 0
+    std::array<std::array<int, max_classes>, Automaton::max_states> child {};
+    for (auto& row : child) row.fill(-1);
+    std::array<std::array<std::uint8_t, max_classes>, Automaton::max_states> next {};
+    a.value.fill(-1);
 
-    return {
-        .pos = max_digit,
-        .val = (max_digit == cend(row)) ? -1 : *max_digit - '0'
+    auto class_for = [&](char c) -> std::uint8_t {
+        auto& cls = class_of[static_cast<unsigned char>(c)];
+        if (cls == 0) cls = static_cast<std::uint8_t>(no_of_classes++);
+        return cls;
     };
+    auto insert = [&](std::string_view key, int value) {
+        int state = 0;
+        for (std::size_t i = 0; i < key.size(); ++i) {
+            const std::uint8_t cls = class_for(key[is_reversed ? key.size() - 1 - i : i]);
+            if (child[state][cls] == -1) child[state][cls] = static_cast<int>(no_of_states++);
+            state = child[state][cls];
+        }
+        a.value[state] = static_cast<std::int8_t>(value);
+    };
+    for (int d = 0; d <= 9; ++d) {
+        insert(std::string_view{"0123456789"}.substr(d, 1), d);
+    }
+    for (std::size_t i = 0; i < number_words.size(); ++i) {
+        insert(number_words[i], static_cast<int>(i) + 1);
+    }
+    if (no_of_states > Automaton::max_states || no_of_classes > max_classes) {
+        throw "Automaton too small"; // NB: in a constant expression this is a compile error
+    }
 
-}
+    // breadth first, so a state's failure target is always finished before the state itself
+    std::array<std::uint8_t, Automaton::max_states> fail {};
+    std::array<std::uint8_t, Automaton::max_states> queue {};
+    std::size_t head = 0, tail = 0;
+    for (std::size_t cls = 0; cls < max_classes; ++cls) {
+        const int c = child[0][cls];
+        next[0][cls] = static_cast<std::uint8_t>(c == -1 ? 0 : c);
+        if (c != -1) queue[tail++] = static_cast<std::uint8_t>(c);
+    }
+    while (head != tail) {
+        const std::uint8_t state = queue[head++];
+        for (std::size_t cls = 0; cls < max_classes; ++cls) {
+            const int c = child[state][cls];
+            if (c == -1) {
+                next[state][cls] = next[fail[state]][cls];
+                continue;
+            }
+            next[state][cls] = static_cast<std::uint8_t>(c);
+            fail[c] = next[fail[state]][cls];
+            if (a.value[c] < 0) a.value[c] = a.value[fail[c]]; // a shorter key ending at the same place
+            queue[tail++] = static_cast<std::uint8_t>(c);
+        }
+    }
 
-Info leftmost_digit_info(const std::string& row) { // FOR P1
-    return n_most_digit_info(row, std::less<>());
+    for (std::size_t state = 0; state < no_of_states; ++state) {
+        for (std::size_t byte = 0; byte < 256; ++byte) {
+            a.next[state][byte] = next[state][class_of[byte]];
+        }
+    }
+    return a;
 }
 
-Info rightmost_digit_info(const std::string& row) { // FOR P1
-    return n_most_digit_info(row, std::greater<>());
+constexpr Automaton forward_automaton = make_automaton(false);
+constexpr Automaton backward_automaton = make_automaton(true);
+
+// calibration_sum(), FOR P1
+
+class DigitCalibration {
+    /// Running state for part 1's sum: the first and last digit of the line being read
+    std::int64_t m_sum = 0;
+    int m_first = -1;
+    int m_last = -1;
+public:
+    void digit(char c) {
+        if (m_first == -1) m_first = c - '0';
+        m_last = c - '0';
+    }
+    void end_of_line() {
+        m_sum += 10 * m_first + m_last;
+        m_first = m_last = -1;
+    }
+    [[nodiscard]] std::int64_t sum() const { return m_sum; }
+};
+
+void calibrate_scalar(std::string_view input, DigitCalibration& calibration) {
+    for (const char c : input) {
+        if (c == '\n') calibration.end_of_line();
+        else if (c >= '0' && c <= '9') calibration.digit(c);
+    }
 }
 
-// ... written_info()
-
-template <typename Compare>
-Info n_most_written_info(const std::string& row, Compare comp) {
-    /// std::less<>() for leftmost, std::greater<>() for rightmost
-
-    std::optional<std::string::size_type> n_most_pos{};
-    int corresponding_int = -1;
-
-    for (const auto& word : number_words) {
-        std::string::size_type pos = 0;
-        while (pos != std::string::npos) {
-            pos = row.find(word, pos);
-            if (pos != std::string::npos) {
-                if (!n_most_pos.has_value() || comp(pos, n_most_pos)) {
-                    n_most_pos = pos;
-                    corresponding_int = word_to_int[word];
-                }
-                ++pos;
+#if defined(__x86_64__)
+__attribute__((target("avx2")))
+void calibrate_avx2(std::string_view input, DigitCalibration& calibration) {
+    /// 32 bytes at a time: one bitmask of digits and one of newlines, so only digits that start or end a line and the
+    /// newlines themselves are ever looked at individually
+    const char* const data = input.data();
+    const std::size_t no_of_blocks = input.size() / 32;
+    const __m256i zero = _mm256_set1_epi8('0');
+    const __m256i nine = _mm256_set1_epi8(9);
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    for (std::size_t block = 0; block < no_of_blocks; ++block) {
+        const char* const bytes = data + 32 * block;
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes));
+        const __m256i offset = _mm256_sub_epi8(v, zero);
+        std::uint64_t digits = static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(offset, nine), offset)));
+        std::uint64_t newlines = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline)));
+
+        while (newlines != 0) {
+            const int nl = std::countr_zero(newlines);
+            const std::uint64_t line_digits = digits & ((std::uint64_t{1} << nl) - 1);
+            if (line_digits != 0) {
+                calibration.digit(bytes[std::countr_zero(line_digits)]);
+                calibration.digit(bytes[63 - std::countl_zero(line_digits)]);
             }
+            calibration.end_of_line();
+            digits &= ~((std::uint64_t{2} << nl) - 1);
+            newlines &= newlines - 1;
+        }
+        if (digits != 0) {
+            calibration.digit(bytes[std::countr_zero(digits)]);
+            calibration.digit(bytes[63 - std::countl_zero(digits)]);
         }
     }
-
-    return {
-        .pos = n_most_pos.has_value() ? cbegin(row) + static_cast<long>(n_most_pos.value()) : cend(row),
-        .val = corresponding_int
-    };
-
+    calibrate_scalar(input.substr(32 * no_of_blocks), calibration);
 }
+#endif
 
-// _most()
+std::int64_t calibration_sum(std::string_view input) {
+    /// Sum of 10 * first digit + last digit over the lines, straight off the buffer without splitting it into lines
+    /// NB: no parse phase, the buffer is only read the once
+    const aoc::Phase phase {"q1 solve: calibration_sum"};
+    DigitCalibration calibration;
+#if defined(__x86_64__)
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    if (has_avx2) calibrate_avx2(input, calibration);
+    else calibrate_scalar(input, calibration);
+#else
+    calibrate_scalar(input, calibration);
+#endif
+    if (!input.empty() && input.back() != '\n') {
+        calibration.end_of_line(); // NB: like aoc::lines, a last line without its '\n' still counts
+    }
+    return calibration.sum();
+}
 
-template <typename Compare>
-int n_most(const std::string& row, Compare compare) {
-    /// std::less<>() for leftmost, std::greater<>() for rightmost
+// first_and_last()
 
-    const Info written_info = n_most_written_info(row, compare);
-    const Info digit_info = n_most_digit_info(row, compare);
+struct FirstAndLast {
+    int first = -1;
+    int last = -1;
+};
 
-    assert((written_info.val != -1) || (digit_info.val != -1));
-    if (written_info.val == -1) {
-        return digit_info.val;
-    }
-    else if (digit_info.val == -1) {
-        return written_info.val;
-    }
-    else {
-        return compare(written_info.pos, digit_info.pos) ? written_info.val : digit_info.val;
+int leftmost(std::string_view row) {
+    /// Runs the automaton from the front of the row, stopping at the first digit or word to end
+    std::uint8_t state = 0;
+    for (const char c : row) {
+        state = forward_automaton.step(state, c);
+        if (forward_automaton.value[state] >= 0) return forward_automaton.value[state];
     }
+    return -1;
+}
 
+int rightmost(std::string_view row) {
+    /// Runs the reversed automaton from the back of the row, so the first match it completes is the one that starts
+    /// furthest right
+    std::uint8_t state = 0;
+    for (auto it = crbegin(row); it != crend(row); ++it) {
+        state = backward_automaton.step(state, *it);
+        if (backward_automaton.value[state] >= 0) return backward_automaton.value[state];
+    }
+    return -1;
 }
 
-int leftmost(const std::string& row) {
-    return n_most(row, std::less<>());
+FirstAndLast first_and_last(std::string_view row) {
+    /// Scans in from both ends, so only the stretches before the first match and after the last are read
+    const FirstAndLast result {.first = leftmost(row), .last = rightmost(row)};
+    assert(result.first != -1);
+    return result;
 }
 
-int rightmost(const std::string& row){
-    return n_most(row, std::greater<>());
+aoc::Answer solve_part_1(std::string_view input) {
+    return calibration_sum(input);
 }
 
-template<typename T>
-std::vector<T> vectorize(std::istream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
+aoc::Answer solve_part_2(std::string_view input) {
+    const aoc::Phase phase {"q1 solve: first_and_last"};
+    aoc::Answer sum = 0;
+    while (!input.empty()) {
+        const FirstAndLast digits = first_and_last(aoc::next_line(input));
+        sum += 10 * digits.first + digits.last;
     }
-    return vec;
+    return sum;
 }
 
-int main() {
+// calibrate(), both parts in one pass
 
-    std::ifstream data("./data.txt");
-    if (!data.is_open()) {
-        throw std::runtime_error("Unable to open file");
+struct Calibration {
+    aoc::Answer part_1 = 0;
+    aoc::Answer part_2 = 0;
+};
+
+struct End {
+    int digit = -1;        // FOR P1
+    int digit_or_word = -1; // FOR P2
+};
+
+template <typename It>
+End scan_in_from(It first, It last, const Automaton& automaton) {
+    /// Stops at the first digit, as the first digit or word is never further in
+    End end;
+    std::uint8_t state = 0;
+    for (; first != last; ++first) {
+        state = automaton.step(state, *first);
+        if (const int value = automaton.value[state]; value >= 0) {
+            if (end.digit_or_word == -1) end.digit_or_word = value;
+            if (*first >= '0' && *first <= '9') {
+                end.digit = value;
+                break;
+            }
+        }
     }
+    return end;
+}
 
-    const std::vector<std::string> lines = vectorize<std::string>(data);
+Calibration calibrate_chunk(std::string_view chunk) {
+    Calibration calibration;
+    while (!chunk.empty()) {
+        const std::string_view line = aoc::next_line(chunk);
+        const End front = scan_in_from(cbegin(line), cend(line), forward_automaton);
+        const End back = scan_in_from(crbegin(line), crend(line), backward_automaton);
+        calibration.part_1 += 10 * front.digit + back.digit;
+        calibration.part_2 += 10 * front.digit_or_word + back.digit_or_word;
+    }
+    return calibration;
+}
 
-    const int part_1 = std::accumulate(cbegin(lines), cend(lines), 0, [&](int acc, const std::string& l){
-        return acc + 10 * leftmost_digit_info(l).val + rightmost_digit_info(l).val;
-    });
+std::vector<std::string_view> split_at_newlines(std::string_view input, std::size_t no_of_chunks) {
+    /// Roughly equal chunks that each end just after a '\n' (bar the last), so no line is split between two
+    std::vector<std::string_view> chunks;
+    std::size_t start = 0;
+    for (std::size_t i = 1; i <= no_of_chunks && start < input.size(); ++i) {
+        std::size_t end = (i == no_of_chunks) ? input.size() : std::max(start, input.size() * i / no_of_chunks);
+        if (end < input.size()) {
+            const auto newline = input.find('\n', end);
+            end = (newline == std::string_view::npos) ? input.size() : newline + 1;
+        }
+        chunks.push_back(input.substr(start, end - start));
+        start = end;
+    }
+    return chunks;
+}
 
-    const int part_2 = std::accumulate(cbegin(lines), cend(lines), 0, [&](int acc, const std::string& l){
-        return acc + 10 * leftmost(l) + rightmost(l);
+Calibration calibrate(std::string_view input, aoc::ThreadPool* pool) {
+    /// Both parts' sums from one read of the input, spread over `pool` if given
+    const std::vector<std::string_view> chunks = split_at_newlines(input, (pool == nullptr) ? 1 : pool->size() * 4);
+    std::vector<Calibration> partial_sums(chunks.size());
+    aoc::parallel_for(pool, chunks.size(), [&](std::size_t begin, std::size_t end){
+        for (std::size_t i = begin; i < end; ++i) {
+            partial_sums[i] = calibrate_chunk(chunks[i]);
+        }
     });
+    return std::accumulate(cbegin(partial_sums), cend(partial_sums), Calibration{}, [](Calibration acc, const Calibration& c){
+        return Calibration{acc.part_1 + c.part_1, acc.part_2 + c.part_2};
+    });
+}
+
+}
+
+#ifndef AOC_NO_MAIN
+int main() {
+
+    const aoc::MappedFile data("./data.txt");
+    aoc::ThreadPool pool;
+    const q1::Calibration calibration = q1::calibrate(data.view(), &pool);
 
-    fmt::print("Part 1: {}\n", part_1);
-    fmt::print("Part 2: {}\n", part_2);
+    fmt::print("Part 1: {}\n", calibration.part_1);
+    fmt::print("Part 2: {}\n", calibration.part_2);
 
     return 0;
 }
+#endif
@@ -1,14 +1,24 @@
 #include <cassert>
 #include <fmt/format.h>
-#include <fstream>
 #include <iostream>
 #include <map>
 #include <numeric>
+#include <optional>
 #include <queue>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "common/Days.h"
+#include "common/Grid.h"
+#include "common/Input.h"
+#include "common/Instrument.h"
+
+namespace q10 {
 
 // TYPES
 
-using SheepMap = std::vector<std::vector<char>>;
+using SheepMap = aoc::Grid<char>; // padded with '.', so stepping off the edge reads as ground
 
 using Location = std::pair<size_t, size_t>;
 enum class Direction {UP, DOWN, LEFT, RIGHT};
@@ -24,48 +34,17 @@ Location operator+(const Location& coord, const Direction& direction) {
 
 // FILE PARSING
 
-template<typename T>
-[[nodiscard]] SheepMap tokenize(const std::vector<T>& lines_of_data) {
-
-    SheepMap tokenized_lines_of_data;
-    for (const auto& line : lines_of_data) {
-        const std::vector<char> tokens = [&](){
-            std::vector<char> tokens;
-            for (const char c : line){
-                tokens.push_back(c);
-            }
-            return tokens;
-        }();
-        tokenized_lines_of_data.push_back(tokens);
-    }
-
-    return tokenized_lines_of_data;
-}
-
-template<typename T>
-[[nodiscard]] std::vector<T> vectorize(std::ifstream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
-    }
-    return vec;
-}
-
-SheepMap parse(std::string_view file_name) {
-    std::ifstream data(file_name);
-    if (!data.is_open()) {
-        throw std::runtime_error("Unable to open file");
-    }
-    return tokenize(vectorize<std::string>(data));
+SheepMap parse(std::string_view data) {
+    const aoc::Phase phase {"q10 parse"};
+    return SheepMap{aoc::grid_view(data), [](char c){ return c; }, 1, '.'};
 }
 
 // HELPER FUNCTION(S)
 
 Location find_S(const SheepMap& map) { // std::pair<row, col>
-    for (size_t row = 0; row < map.size(); ++row){
-        for (size_t col = 0; col < map.front().size(); ++col){
-            if (map[row][col] == 'S') {
+    for (size_t row = 0; row < map.height(); ++row){
+        for (size_t col = 0; col < map.width(); ++col){
+            if (map(row, col) == 'S') {
                 return {row, col};
             }
         }
@@ -101,7 +80,7 @@ void update_max(std::optional<unsigned>& current_max, std::optional<unsigned> ca
 struct PathTravellerData {
     Location starting_location;
     Direction travel_direction;
-    SheepMap map;
+    aoc::GridView<const char> map;
     bool requires_path_points;
 };
 
@@ -119,7 +98,7 @@ std::tuple<std::optional<unsigned>, std::vector<Location>> path_traveller(PathTr
     do {
         all_path_points.push_back(current);
         current = current + data.travel_direction;
-        char_at_dest_square = data.map[current.first][current.second];
+        char_at_dest_square = data.map(current.first, current.second);
 
         if (char_at_dest_square == '.') {
             return {std::nullopt, all_path_points};
@@ -146,7 +125,7 @@ std::tuple<std::optional<unsigned>, std::vector<Location>> path_traveller(PathTr
 std::optional<Direction> calc_next_direction(Location start, Direction direction, const SheepMap& map) {
     std::pair<Direction,Direction> possible_directions;
     try {
-        possible_directions = valid_directions_from_pipe.at(map[start.first][start.second]);
+        possible_directions = valid_directions_from_pipe.at(map(start.first, start.second));
     }
     catch (std::out_of_range& err) { // key not found
         return std::nullopt;
@@ -175,7 +154,7 @@ std::vector<Location> calc_path_points(const SheepMap& map){
         std::optional<unsigned> path_length = get<0>(path_traveller({
             .starting_location = candidate_start_position
             , .travel_direction = first_step_direction.value()
-            , .map = map
+            , .map = map.view()
             , .requires_path_points = false
         }));
 
@@ -194,7 +173,7 @@ std::vector<Location> calc_path_points(const SheepMap& map){
     const std::vector<Location> path_points = get<1>(path_traveller({
         .starting_location = start_position
         , .travel_direction = calc_next_direction(start_position, direction, map).value()
-        , .map = map
+        , .map = map.view()
         , .requires_path_points = true
     }));
 
@@ -223,6 +202,7 @@ unsigned points_in_polygon(const std::vector<Location>& points) {
 // SOLUTION FUNCTIONS
 
 unsigned calc_part_1(const SheepMap& map){
+    const aoc::Phase phase {"q10 solve: calc_part_1"};
 
     const Location start_location = find_S(map);
     std::optional<unsigned> max_length_loop = std::nullopt;
@@ -237,7 +217,7 @@ unsigned calc_part_1(const SheepMap& map){
         std::optional<unsigned> path_length = get<0>(path_traveller({
             .starting_location = candidate_start_position
             , .travel_direction = first_step_direction.value()
-            , .map = map
+            , .map = map.view()
             , .requires_path_points = false
         }));
 
@@ -248,12 +228,25 @@ unsigned calc_part_1(const SheepMap& map){
 }
 
 unsigned calc_part_2(const SheepMap& map) {
+    const aoc::Phase phase {"q10 solve: calc_part_2"};
     return points_in_polygon(calc_path_points(map));
 }
 
+aoc::Answer solve_part_1(std::string_view input) {
+    return calc_part_1(parse(input));
+}
+
+aoc::Answer solve_part_2(std::string_view input) {
+    return calc_part_2(parse(input));
+}
+
+}
+
+#ifndef AOC_NO_MAIN
 int main() {
-    const SheepMap map = parse("../map.txt");
-    fmt::print("Part 1: {}\n", calc_part_1(map));
-    fmt::print("Part 2: {}\n", calc_part_2(map));
+    const aoc::MappedFile data("../map.txt");
+    fmt::print("Part 1: {}\n", q10::solve_part_1(data.view()));
+    fmt::print("Part 2: {}\n", q10::solve_part_2(data.view()));
     return 0;
 }
+#endif
@@ -1,53 +1,45 @@
 #include "Universe.h"
+#include "../common/Input.h"
 
-UniverseMap Universe::parse(std::string_view file_name) {
-    std::ifstream data(file_name);
-    if (!data.is_open()) {
-        throw std::runtime_error("Unable to open file");
-    }
-    UniverseMap m = tokenize(vectorize<std::string>(data));
-    return m;
+#include <algorithm>
+
+namespace q11 {
+
+UniverseMap Universe::parse(std::string_view data) {
+    return aoc::grid_view(data);
 }
 
 void Universe::reserve_and_set() {
-    multiplier_map.reserve(universe_map.size());
-    for (size_t row = 0; row < universe_map.size(); ++row) {
-        multiplier_map.emplace_back();
-        multiplier_map[row].reserve(universe_map[row].size());
-        multiplier_map[row].resize(universe_map[row].size(), 0);
-    }
+    multiplier_map = MultiplierMap(universe_map.height(), universe_map.width(), 0);
 }
 
 void Universe::process_column(size_t col) {
-    for (size_t row = 0; row < universe_map.size(); ++row) {
-        if (universe_map[row][col] == '#') { return; }
-    }
-    for (size_t row = 0; row < multiplier_map.size(); ++row) {
-        multiplier_map[row][col] = 1;
+    if (std::ranges::none_of(universe_map.column(col), [](const char c) { return c == '#'; })) {
+        std::ranges::fill(multiplier_map.column(col), 1);
     }
 }
 
 void Universe::init_multiplier_map() {
     reserve_and_set();
-    for (size_t row = 0; row < universe_map.size(); ++row) {
-        if (std::ranges::none_of(universe_map[row], [](const char c) { return c == '#'; })) {
-            std::ranges::fill(multiplier_map[row], 1);
+    for (size_t row = 0; row < universe_map.height(); ++row) {
+        if (std::ranges::none_of(universe_map.row_span(row), [](const char c) { return c == '#'; })) {
+            std::ranges::fill(multiplier_map.row_span(row), 1);
         }
     }
-    for (size_t col = 0; col < universe_map.front().size(); ++col) {
+    for (size_t col = 0; col < universe_map.width(); ++col) {
         process_column(col);
     }
 }
 
-Universe::Universe(std::string_view file_name) : universe_map{parse(file_name)} {
+Universe::Universe(std::string_view data) : universe_map{parse(data)} {
     init_multiplier_map();
 }
 
 std::vector<Universe::Location> Universe::get_galaxy_locations() const {
     std::vector<Location> galaxy_locations;
-    for (size_t row = 0; row < universe_map.size(); ++row) {
-        for (size_t col = 0; col < universe_map[row].size(); ++col) {
-            if (universe_map[row][col] == '#') {
+    for (size_t row = 0; row < universe_map.height(); ++row) {
+        for (size_t col = 0; col < universe_map.width(); ++col) {
+            if (universe_map(row, col) == '#') {
                 galaxy_locations.emplace_back(row, col);
             }
         }
@@ -61,7 +53,7 @@ unsigned Universe::calc_expansion_rows(Universe::Location src, Universe::Locatio
     }
     unsigned count = 0;
     for (size_t row = src.first; row < dst.first; ++row) {
-        if (multiplier_map[row].front() == 1) {
+        if (multiplier_map(row, 0) == 1) {
             ++count;
         }
     }
@@ -74,7 +66,7 @@ unsigned Universe::calc_expansion_cols(Universe::Location src, Universe::Locatio
     }
     unsigned count = 0;
     for (size_t col = src.second; col < dst.second; ++col) {
-        if (multiplier_map.front()[col] == 1) {
+        if (multiplier_map(0, col) == 1) {
             ++count;
         }
     }
@@ -109,3 +101,5 @@ unsigned long long Universe::part_n_solution(int EXPANSION_MULTIPLIER) const {
     }
     return total;
 }
+
+}
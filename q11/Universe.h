@@ -1,6 +1,9 @@
 #pragma once
 #include "Utils.h"
 #include <map>
+#include <string_view>
+
+namespace q11 {
 
 class Universe {
 public:
@@ -9,7 +12,7 @@ private:
     UniverseMap universe_map;
     MultiplierMap multiplier_map;
 
-    static UniverseMap parse(std::string_view file_name);
+    static UniverseMap parse(std::string_view data);
     void reserve_and_set();
     void process_column(size_t col);
     void init_multiplier_map();
@@ -17,9 +20,11 @@ private:
     [[nodiscard]] unsigned calc_expansion_cols(Location src, Location dst) const;
     [[nodiscard]] unsigned long long part_n_solution(int EXPANSION_MULTIPLIER) const;
 public:
-    explicit Universe(std::string_view file_name);
+    explicit Universe(std::string_view data); // NB: `data` must outlive the Universe
     [[nodiscard]] unsigned part_1_solution() const;
     [[nodiscard]] unsigned long part_2_solution() const;
     [[nodiscard]] std::vector<Location> get_galaxy_locations() const;
     [[nodiscard]] unsigned shortest_path(Location src, Location dst, int EXPANSION_MULTIPLIER) const;
 };
+
+}
@@ -1,21 +1,14 @@
 #pragma once
 
-#include <fstream>
 #include <iostream>
+#include <string_view>
 #include <vector>
 
-using UniverseMap = std::vector<std::vector<char>>;
-using MultiplierMap = std::vector<std::vector<int>>;
+#include "../common/Grid.h"
 
-[[nodiscard]] UniverseMap tokenize(const std::vector<std::string>& lines_of_data);
+namespace q11 {
 
-template<typename T>
-[[nodiscard]] std::vector<T> vectorize(std::ifstream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
-    }
-    return vec;
-}
+using UniverseMap = aoc::GridView<const char>; // NB: views the input buffer in place
+using MultiplierMap = aoc::Grid<int>;
 
+}
@@ -1,10 +1,36 @@
 #include <fmt/format.h>
 #include <iostream>
 #include "Universe.h"
+#include "../common/Days.h"
+#include "../common/Input.h"
+#include "../common/Instrument.h"
 
+namespace q11 {
+
+Universe parse(std::string_view input) {
+    const aoc::Phase phase {"q11 parse: Universe"};
+    return Universe(input);
+}
+
+aoc::Answer solve_part_1(std::string_view input) {
+    const Universe universe = parse(input);
+    const aoc::Phase phase {"q11 solve: part_1_solution"};
+    return universe.part_1_solution();
+}
+
+aoc::Answer solve_part_2(std::string_view input) {
+    const Universe universe = parse(input);
+    const aoc::Phase phase {"q11 solve: part_2_solution"};
+    return static_cast<aoc::Answer>(universe.part_2_solution());
+}
+
+}
+
+#ifndef AOC_NO_MAIN
 int main() {
-    const Universe universe = Universe("../star_map.txt");
-    fmt::print("Part 1: {}\n", universe.part_1_solution());
-    fmt::print("Part 2: {}\n", universe.part_2_solution());
+    const aoc::MappedFile data("../star_map.txt");
+    fmt::print("Part 1: {}\n", q11::solve_part_1(data.view()));
+    fmt::print("Part 2: {}\n", q11::solve_part_2(data.view()));
     return 0;
 }
+#endif
@@ -1,95 +1,82 @@
 #include <algorithm>
 #include <fmt/format.h>
-#include <fstream>
 #include <iostream>
+#include <limits>
 #include <numeric>
+#include <string_view>
+#include <vector>
 
-using AshRockMap = std::vector<std::vector<char>>;
+#include "common/Days.h"
+#include "common/Grid.h"
+#include "common/Input.h"
+#include "common/Instrument.h"
+
+namespace q13 {
+
+using AshRockMap = aoc::GridView<const char>; // NB: views the input buffer in place
 
 // ORGANIZE DATA
 
-std::vector<AshRockMap> split(const AshRockMap& map) {
-    std::vector<AshRockMap> split_input;
-    AshRockMap current;
-    for (const auto& line : map) {
+std::vector<std::string_view> split(std::string_view data) {
+    /// blank-line separated blocks, each without its trailing newline
+    std::vector<std::string_view> blocks;
+    const char* block_start = data.data();
+    const char* block_end = data.data();
+    while (!data.empty()) {
+        const std::string_view line = aoc::next_line(data);
         if (!line.empty()) {
-            current.push_back(line);
+            if (block_end <= block_start) block_start = line.data(); // NB: first line after blank ones
+            block_end = line.data() + line.size();
         }
-        else {
-            split_input.push_back(current);
-            current.clear();
+        else if (block_start < block_end) {
+            blocks.emplace_back(block_start, block_end);
+            block_start = block_end;
         }
     }
-    split_input.push_back(current);
-    return split_input;
-}
-
-AshRockMap tokenize(const std::vector<std::string> &lines_of_data) {
-    AshRockMap tokenized_lines_of_data;
-    for (const auto& line : lines_of_data) {
-        const std::vector<char> tokens = [&](){
-            std::vector<char> tokens;
-            for (const char c : line){
-                tokens.push_back(c);
-            }
-            return tokens;
-        }();
-        tokenized_lines_of_data.push_back(tokens);
+    if (block_start < block_end) {
+        blocks.emplace_back(block_start, block_end);
     }
-    return tokenized_lines_of_data;
+    return blocks;
 }
 
-template<typename T>
-[[nodiscard]] std::vector<T> vectorize(std::ifstream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
+std::vector<AshRockMap> parse(std::string_view data) {
+    const aoc::Phase phase {"q13 parse"};
+    std::vector<AshRockMap> maps;
+    for (const std::string_view block : split(data)) {
+        maps.push_back(aoc::grid_view(block));
     }
-    return vec;
-}
-
-std::vector<AshRockMap> parse(std::string_view file_name) {
-    std::ifstream data(file_name);
-    if (!data.is_open()) {
-        throw std::runtime_error("Unable to open file");
-    }
-    std::vector<AshRockMap> map = split(tokenize(vectorize<std::string>(data)));
-    return map;
+    return maps;
 }
 
 // HELPERS
 
 bool one_off_row_match(size_t row_ix_a, size_t row_ix_b, const AshRockMap& map) {
-    const auto& row_a = map[row_ix_a];
-    const auto& row_b = map[row_ix_b];
+    const auto row_a = map.row(row_ix_a);
+    const auto row_b = map.row(row_ix_b);
 
-    unsigned mismatchCount = std::inner_product(begin(row_a), end(row_a), begin(row_b), 0, std::plus<>(), [](char a, char b) {
+    unsigned mismatchCount = std::inner_product(row_a.begin(), row_a.end(), row_b.begin(), 0, std::plus<>(), [](char a, char b) {
         return (a != b) ? 1 : 0;
     });
 
     return mismatchCount == 1;
 }
 bool one_off_col_match(size_t col_ix_a, size_t col_ix_b, const AshRockMap& map) {
-    return std::ranges::count_if(map, [&](const auto& row) {
-        return row[col_ix_a] != row[col_ix_b];
-    }) == 1;
+    return one_off_row_match(col_ix_a, col_ix_b, map.transposed());
+}
+
+bool compare_rows(size_t ix_a, size_t ix_b, const AshRockMap& map) {
+    return std::ranges::equal(map.row(ix_a), map.row(ix_b));
 }
 
 bool compare_verticals(size_t ix_a, size_t ix_b, const AshRockMap& map) {
-    for (size_t r = 0; r < map.size(); ++r) {
-        if (map[r][ix_a] != map[r][ix_b]) {
-            return false;
-        }
-    }
-    return true;
+    return compare_rows(ix_a, ix_b, map.transposed());
 };
 
 bool is_horizontal_reflection(size_t starting_ix, const AshRockMap& map, unsigned smudges_remaining = 0) {
     size_t upper = starting_ix-1;
     size_t lower = starting_ix+2;
-    while (upper != std::numeric_limits<size_t>::max() && lower < map.size()) { // upper: ... -> 1 -> 0 -> num_limit::max()
-        if (map[upper] != map[lower]) {
+    while (upper != std::numeric_limits<size_t>::max() && lower < map.height()) { // upper: ... -> 1 -> 0 -> num_limit::max()
+        if (!compare_rows(upper, lower, map)) {
             if (smudges_remaining == 0 || !one_off_row_match(upper, lower, map)) {
                 return false;
             }
@@ -103,7 +90,7 @@ bool is_horizontal_reflection(size_t starting_ix, const AshRockMap& map, unsigne
 bool is_vertical_reflection(size_t starting_ix, const AshRockMap& map, unsigned smudges_remaining = 0) {
     size_t left = starting_ix-1;
     size_t right = starting_ix+2;
-    while (left != std::numeric_limits<size_t>::max() && right < map.front().size()) { // left: ... -> 1 -> 0 -> num_limit::max()
+    while (left != std::numeric_limits<size_t>::max() && right < map.width()) { // left: ... -> 1 -> 0 -> num_limit::max()
         if (!compare_verticals(left, right, map)) {
             if (smudges_remaining == 0 || !one_off_col_match(left, right, map)) {
                 return false;
@@ -118,7 +105,7 @@ bool is_vertical_reflection(size_t starting_ix, const AshRockMap& map, unsigned
 
 std::vector<size_t> get_upper_ix_of_all_near_horizontal_twins(const AshRockMap& map) {
     std::vector<size_t> upper_ixes;
-    for (size_t r = 0; r < map.size()-1; ++r) {
+    for (size_t r = 0; r < map.height()-1; ++r) {
         if (one_off_row_match(r, r+1, map)) {
             upper_ixes.push_back(r);
         }
@@ -127,7 +114,7 @@ std::vector<size_t> get_upper_ix_of_all_near_horizontal_twins(const AshRockMap&
 }
 std::vector<size_t> get_left_ix_of_all_near_vertical_twins(const AshRockMap& map) {
     std::vector<size_t> left_ixes;
-    for (size_t col = 0; col < map.front().size()-1; ++col) {
+    for (size_t col = 0; col < map.width()-1; ++col) {
         if (one_off_col_match(col, col+1, map)) {
             left_ixes.push_back(col);
         }
@@ -154,8 +141,8 @@ std::vector<size_t> get_left_ix_of_vertical_reflections(const std::vector<size_t
 }
 std::vector<size_t> get_upper_ix_of_all_horizontal_twins(const AshRockMap& map) {
     std::vector<size_t> upper_ixes;
-    for (size_t i = 0; i < map.size()-1; ++i) {
-        if (map[i] == map[i+1]) {
+    for (size_t i = 0; i < map.height()-1; ++i) {
+        if (compare_rows(i, i+1, map)) {
             upper_ixes.push_back(i);
         }
     }
@@ -163,7 +150,7 @@ std::vector<size_t> get_upper_ix_of_all_horizontal_twins(const AshRockMap& map)
 }
 std::vector<size_t> get_left_ix_of_all_vertical_twins(const AshRockMap& map) {
     std::vector<size_t> left_ixes;
-    for (size_t col = 0; col < map.front().size()-1; ++col) {
+    for (size_t col = 0; col < map.width()-1; ++col) {
         if (compare_verticals(col, col+1, map)) {
             left_ixes.push_back(col);
         }
@@ -237,20 +224,34 @@ unsigned map_to_num(const AshRockMap& map, bool is_smudged = false) {
 // SOLUTIONS
 
 unsigned part_1(const std::vector<AshRockMap>& maps) {
+    const aoc::Phase phase {"q13 solve: part_1"};
     return std::accumulate(begin(maps), end(maps), 0u, [](unsigned acc, const AshRockMap& map){
         return acc + map_to_num(map, false);
     });
 }
 unsigned part_2(const std::vector<AshRockMap>& maps) {
+    const aoc::Phase phase {"q13 solve: part_2"};
     return std::accumulate(begin(maps), end(maps), 0u, [](unsigned acc, const AshRockMap& map){
         return acc + map_to_num(map, true);
     });
 }
 
+aoc::Answer solve_part_1(std::string_view input) {
+    return part_1(parse(input));
+}
+
+aoc::Answer solve_part_2(std::string_view input) {
+    return part_2(parse(input));
+}
+
+}
+
+#ifndef AOC_NO_MAIN
 int main() {
 
-    const std::vector<AshRockMap> input = parse("../maps.txt");
-    fmt::print("Part 1: {}\n", part_1(input));
-    fmt::print("Part 2: {}\n", part_2(input));
+    const aoc::MappedFile data("../maps.txt");
+    fmt::print("Part 1: {}\n", q13::solve_part_1(data.view()));
+    fmt::print("Part 2: {}\n", q13::solve_part_2(data.view()));
     return 0;
 }
+#endif
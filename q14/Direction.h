@@ -1,5 +1,7 @@
 #pragma once
 
+namespace q14 {
+
 class Direction {
     int m_row_delta;
     int m_col_delta;
@@ -16,4 +18,4 @@ public:
     [[nodiscard]] int col_delta() const { return m_col_delta; }
 };
 
-
+}
@@ -1,5 +1,7 @@
 #include "Position.h"
 
+namespace q14 {
+
 bool operator==(const Position& pos, const Position& other) {
     return pos.row_ix == other.row_ix && pos.col_ix == other.col_ix;
 }
@@ -7,3 +9,5 @@ bool operator==(const Position& pos, const Position& other) {
 std::size_t PositionHash::operator()(const Position &pos) const {
     return std::hash<gsl::index>()(pos.row_ix) ^ (std::hash<gsl::index>()(pos.col_ix) << 1);
 }
+
+}
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <functional>
 #include <gsl/gsl>
 
+namespace q14 {
+
 struct Position {
     gsl::index row_ix, col_ix;
     friend bool operator==(const Position& pos, const Position& other);
@@ -11,3 +14,4 @@ struct PositionHash {
     std::size_t operator()(const Position& pos) const;
 };
 
+}
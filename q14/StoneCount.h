@@ -2,6 +2,8 @@
 
 #include "Position.h"
 
+namespace q14 {
+
 struct StoneCount {
     Position stone_position;
     unsigned no_of_stones; // no_of_stones_pushing_on_that_stone
@@ -10,4 +12,6 @@ struct StoneCount {
 
 bool operator==(const StoneCount& sc, const StoneCount& other) {
     return sc.stone_position == other.stone_position && sc.no_of_stones == other.no_of_stones;
-}
\ No newline at end of file
+}
+
+}
@@ -1,20 +1,28 @@
 #include <algorithm>
 #include <fmt/format.h>
-#include <fstream>
 #include <iostream>
 #include <numeric>
 #include <map>
+#include <string_view>
 #include <unordered_set>
 #include <utility>
+#include <vector>
+
+#include "../common/Days.h"
+#include "../common/Grid.h"
+#include "../common/Input.h"
+#include "../common/Instrument.h"
 
 #include "Direction.h"
 #include "Position.h"
 #include "StoneCount.h"
 
-using RockMap = std::vector<std::vector<char>>;
+namespace q14 {
+
+using RockMap = aoc::Grid<char>;
 std::ostream& operator<<(std::ostream& os, const RockMap& map) {
-    for (const auto& row : map) {
-        for (const char col : row) {
+    for (size_t row = 0; row < map.height(); ++row) {
+        for (const char col : map.row_span(row)) {
             os << col;
         }
         os << '\n';
@@ -25,35 +33,9 @@ std::ostream& operator<<(std::ostream& os, const RockMap& map) {
 
 // PARSE DATA FUNCTIONS
 
-RockMap tokenize(const std::vector<std::string> &lines_of_data) {
-    RockMap tokenized_lines_of_data;
-    for (const auto& line : lines_of_data) {
-        const std::vector<char> tokens = [&](){
-            std::vector<char> tokens;
-            std::ranges::copy(line, std::back_inserter(tokens));
-            return tokens;
-        }();
-        tokenized_lines_of_data.push_back(tokens);
-    }
-    return tokenized_lines_of_data;
-}
-
-template<typename T>
-[[nodiscard]] std::vector<T> vectorize(std::ifstream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
-    }
-    return vec;
-}
-
-RockMap parse(std::string_view file_name) {
-    std::ifstream data(file_name);
-    if (!data.is_open()) {
-        throw std::runtime_error("Unable to open file");
-    }
-    RockMap map = tokenize(vectorize<std::string>(data));
+RockMap parse(std::string_view data) {
+    const aoc::Phase phase {"q14 parse"};
+    RockMap map {aoc::grid_view(data), [](char c){ return c; }};
     return map;
 }
 
@@ -69,8 +51,8 @@ unsigned no_of_rolling_rocks(const Position& position, const RockMap& map, const
         unsigned vertical_rolling_rocks = 0;
         auto current_row = position.row_ix - direction.row_delta();
 
-        while (0 <= current_row && current_row < map.size() && map[current_row][position.col_ix] != '#') {
-            if (map[current_row][position.col_ix] == 'O') {
+        while (0 <= current_row && current_row < map.height() && map(current_row, position.col_ix) != '#') {
+            if (map(current_row, position.col_ix) == 'O') {
                 ++vertical_rolling_rocks;
             }
             current_row += increment;
@@ -82,8 +64,8 @@ unsigned no_of_rolling_rocks(const Position& position, const RockMap& map, const
         unsigned horizontal_rolling_rocks = 0;
         auto current_col = position.col_ix - direction.col_delta();
 
-        while (0 <= current_col && current_col < map.front().size() && map[position.row_ix][current_col] != '#') {
-            if (map[position.row_ix][current_col] == 'O') {
+        while (0 <= current_col && current_col < map.width() && map(position.row_ix, current_col) != '#') {
+            if (map(position.row_ix, current_col) == 'O') {
                 ++horizontal_rolling_rocks;
             }
             current_col += increment;
@@ -123,15 +105,15 @@ std::vector<Position> calc_edge_stones(const RockMap& map, const Direction& dire
     std::vector<Position> positions;
 
     if (is_vertical_direction) {
-        const auto& row_size = map.front().size();
-        const gsl::index row_ix = (direction == Direction::up()) ? -1 : gsl::narrow_cast<gsl::index>(map.front().size());
+        const auto& row_size = map.width();
+        const gsl::index row_ix = (direction == Direction::up()) ? -1 : gsl::narrow_cast<gsl::index>(map.width());
         for (gsl::index col_ix = 0; col_ix < row_size; ++col_ix) {
             positions.emplace_back(row_ix, col_ix);
         }
     }
     else {
-        const auto& col_size = map.size();
-        const gsl::index col_ix = (direction == Direction::left()) ? -1 : gsl::narrow_cast<gsl::index>(map.size());
+        const auto& col_size = map.height();
+        const gsl::index col_ix = (direction == Direction::left()) ? -1 : gsl::narrow_cast<gsl::index>(map.height());
         for (gsl::index row_ix = 0; row_ix < col_size; ++row_ix) {
             positions.emplace_back(row_ix, col_ix);
         }
@@ -142,9 +124,9 @@ std::vector<Position> calc_edge_stones(const RockMap& map, const Direction& dire
 
 std::vector<Position> calc_stable_stone_positions(const RockMap& map) {
     std::vector<Position> pos;
-    for (gsl::index row = 0; row < map.size(); ++row) {
-        for (gsl::index col = 0; col < map.front().size(); ++col) {
-            if (map[row][col] == '#') {
+    for (gsl::index row = 0; row < map.height(); ++row) {
+        for (gsl::index col = 0; col < map.width(); ++col) {
+            if (map(row, col) == '#') {
                 pos.emplace_back(row, col);
             }
         }
@@ -184,9 +166,9 @@ std::vector<Position> calc_rolling_stones_positions(const std::vector<StoneCount
 
 std::vector<Position> calc_rolling_stones_positions(const RockMap& map) {
     std::vector<Position> pos;
-    for (gsl::index row = 0; row < map.size(); ++row) {
-        for (gsl::index col = 0; col < map.front().size(); ++col) {
-            if (map[row][col] == 'O') {
+    for (gsl::index row = 0; row < map.height(); ++row) {
+        for (gsl::index col = 0; col < map.width(); ++col) {
+            if (map(row, col) == 'O') {
                 pos.emplace_back(row, col);
             }
         }
@@ -220,21 +202,23 @@ void tilter(const std::vector<Position>& stable_stones,
             const std::vector<Position>& rolling_stones,
             RockMap& map) {
 
+    const aoc::Phase phase {"q14 solve: tilter"};
+
     const auto rolling_stones_set = std::unordered_set<Position, PositionHash>(rolling_stones.begin(), rolling_stones.end());
     const auto stable_stones_set = std::unordered_set<Position, PositionHash>(stable_stones.begin(), stable_stones.end());
 
     //#pragma omp parallel for -- didn't make noticeable difference
-    for (gsl::index row = 0; row < map.size(); ++row) {
-        for (gsl::index col = 0; col < map.front().size(); ++col) {
+    for (gsl::index row = 0; row < map.height(); ++row) {
+        for (gsl::index col = 0; col < map.width(); ++col) {
             const Position current_position = {row, col};
             if (rolling_stones_set.find(current_position) != rolling_stones_set.end()) {
-                map[row][col] = 'O';
+                map(row, col) = 'O';
             }
             else if (stable_stones_set.find(current_position) != stable_stones_set.end()) {
-                map[row][col] = '#';
+                map(row, col) = '#';
             }
             else {
-                map[row][col] = '.';
+                map(row, col) = '.';
             }
         }
     }
@@ -267,12 +251,15 @@ gsl::index nth_cycle_equivalent_to(std::pair<gsl::index, gsl::index> cycle_start
 
 RockMap map_after_n_cycles(RockMap map, unsigned no_of_cycles) {
 
+    const aoc::Phase phase {"q14 solve: map_after_n_cycles"};
+
     std::map<RockMap, gsl::index> cache;
     cache[map] = 0;
 
     auto find_cycle = [&](RockMap& map) -> std::pair<gsl::index, gsl::index> {
         for (gsl::index current_cycle = 1; current_cycle <= no_of_cycles; ++current_cycle) {
             cycle(map);
+            const aoc::Phase cache_phase {"q14 solve: cache"};
             if (cache.contains(map)) {
                 return {cache.at(map), current_cycle - 1};
             }
@@ -307,7 +294,7 @@ unsigned rows_from_south_edge(gsl::index row_ix, size_t no_of_rows){
 unsigned calc_load(const RockMap& map) {
     const std::vector<Position> rolling_stone_positions = calc_rolling_stones_positions(map);
     return std::accumulate(cbegin(rolling_stone_positions), cend(rolling_stone_positions), 0u, [&](unsigned acc, const Position& position){
-        return acc + rows_from_south_edge(position.row_ix, map.size());
+        return acc + rows_from_south_edge(position.row_ix, map.height());
     });
 }
 
@@ -323,9 +310,21 @@ unsigned part_2(RockMap map) {
     return calc_load(final_map);
 }
 
+aoc::Answer solve_part_1(std::string_view input) {
+    return part_1(parse(input));
+}
+
+aoc::Answer solve_part_2(std::string_view input) {
+    return part_2(parse(input));
+}
+
+}
+
+#ifndef AOC_NO_MAIN
 int main() {
-    const RockMap map = parse("../rocks.txt");
-    fmt::print("Part 1: {}\n", map);
-    fmt::print("Part 2: {}\n", map);
+    const aoc::MappedFile data("../rocks.txt");
+    fmt::print("Part 1: {}\n", q14::solve_part_1(data.view()));
+    fmt::print("Part 2: {}\n", q14::solve_part_2(data.view()));
     return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -1,12 +1,21 @@
 #include <boost/algorithm/string/classification.hpp> // Include boost::for is_any_of
 #include <boost/algorithm/string/split.hpp> // Include for boost::split
 #include <boost/filesystem.hpp>
+#include <cassert>
 #include <fmt/format.h>
-#include <fstream>
 #include <iostream>
 #include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "common/Days.h"
+#include "common/Input.h"
+#include "common/Instrument.h"
+
+namespace q15 {
+
 // Custom classes
 
 class InitializationStep {
@@ -34,10 +43,12 @@ public:
     friend std::hash<InitializationStep>;
 };
 
+}
+
 // std::hash implimentation for InitializationStep - overkill but I wanted to try it :)
 namespace std { 
     template <>
-    struct hash<InitializationStep> {
+    struct hash<q15::InitializationStep> {
         size_t operator()(const std::string_view str) const {
             return std::accumulate(cbegin(str), cend(str), size_t{0}, [](size_t acc, char c) {
                 return ((acc + static_cast<size_t>(c)) * 17) % 256;
@@ -46,6 +57,8 @@ namespace std {
     };
 }
 
+namespace q15 {
+
 class Lens {
     std::string m_label;
     std::optional<unsigned> m_focal_length;
@@ -68,24 +81,16 @@ using Box = std::vector<Lens>;
 
 bool is_valid_file(std::string_view file_path){
     namespace fs = boost::filesystem;
-    if (!fs::exists(file_path) || !fs::is_regular_file(file_path)) {
+    const fs::path path {std::string(file_path)};
+    if (!fs::exists(path) || !fs::is_regular_file(path)) {
         fmt::print(stderr, "File does not exist or is not a regular file: {}\n", file_path);
         return false;
     }
     return true;
 }
 
-std::vector<InitializationStep> parse(std::string_view file_path) {
-
-    assert(is_valid_file(file_path));
-
-    std::ifstream file(file_path.data());
-    if (!file.is_open()) {
-        fmt::print(stderr, "File not open: {}\n", file_path);
-        return {};
-    }
-
-    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+std::vector<InitializationStep> parse(std::string_view content) {
+    const aoc::Phase phase {"q15 parse"};
 
     std::vector<std::string> words;
         boost::split(words, content, boost::is_any_of(", "), boost::token_compress_on);
@@ -100,6 +105,7 @@ std::vector<InitializationStep> parse(std::string_view file_path) {
 }
 
 unsigned part_1(const std::vector<InitializationStep>& vec) {
+    const aoc::Phase phase {"q15 solve: part_1"};
     return std::accumulate(cbegin(vec), cend(vec), 0u, [](unsigned acc, const InitializationStep& step) {
         return acc + std::hash<InitializationStep>{}(step.str());
     });
@@ -150,6 +156,7 @@ unsigned calc_focusing_power(const std::array<Box, 256>& boxes) {
 }
 
 unsigned part_2(const std::vector<InitializationStep>& steps) {
+    const aoc::Phase phase {"q15 solve: part_2"};
     std::array<Box, 256> boxes;
     for (const auto& step : steps) {
         follow_initialization_step(boxes, step);
@@ -157,9 +164,22 @@ unsigned part_2(const std::vector<InitializationStep>& steps) {
     return calc_focusing_power(boxes);
 }
 
+aoc::Answer solve_part_1(std::string_view input) {
+    return part_1(parse(input));
+}
+
+aoc::Answer solve_part_2(std::string_view input) {
+    return part_2(parse(input));
+}
+
+}
+
+#ifndef AOC_NO_MAIN
 int main() {
-    const std::vector<InitializationStep> data = parse("../input.txt");
-    fmt::print("Part 1: {}\n", part_1(data));
-    fmt::print("Part 2: {}\n", part_2(data));
+    assert(q15::is_valid_file("../input.txt"));
+    const aoc::MappedFile file("../input.txt");
+    fmt::print("Part 1: {}\n", q15::solve_part_1(file.view()));
+    fmt::print("Part 2: {}\n", q15::solve_part_2(file.view()));
     return 0;
 }
+#endif
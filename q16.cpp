@@ -1,13 +1,22 @@
 #include <boost/algorithm/string/classification.hpp> // Include boost::for is_any_of
 #include <boost/filesystem.hpp>
+#include <cassert>
 #include <fmt/format.h>
-#include <fstream>
 #include <gsl/gsl>
 #include <iostream>
 #include <numeric>
 #include <set>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "common/Days.h"
+#include "common/Grid.h"
+#include "common/Input.h"
+#include "common/Instrument.h"
+
+namespace q16 {
+
 // Custom classes -- TODO: move to seperate files
 
 struct Location {
@@ -93,7 +102,7 @@ public:
 class Grid {
     using Type = Square::Type;
 
-    std::vector<std::vector<Square>> grid;
+    aoc::Grid<Square> grid;
     std::vector<Beam> beams {Beam{}};
     std::set<Beam> cache; // store prev beams to exit early if in loop
 
@@ -165,7 +174,7 @@ class Grid {
 
         for (gsl::index i = 0; i < beams.size(); ++i) {
             auto& beam = beams[i];
-            const Type beam_loc_type = grid[beam.location.row][beam.location.col].type();
+            const Type beam_loc_type = grid(beam.location.row, beam.location.col).type();
             switch (beam_loc_type) {
                 case Type::EMPTY : {
                     beam.location = beam.location + beam.direction;
@@ -205,8 +214,8 @@ class Grid {
     }
 
     void remove_unecessary_beams() {
-        const auto grid_rows = grid.size();
-        const auto grid_cols = grid[0].size();
+        const auto grid_rows = grid.height();
+        const auto grid_cols = grid.width();
 
         std::erase_if(beams, [&](const Beam& b) {
             return cache.contains(b) ||
@@ -218,21 +227,19 @@ class Grid {
     void illuminate_squares() {
         /// Assumes valid grid locations
         for (const Beam& beam : beams) {
-            grid[beam.location.row][beam.location.col].illuminate();
+            grid(beam.location.row, beam.location.col).illuminate();
         }
     }
 
     void delluminate_all() {
-        for (auto& row : grid) {
-            for (auto& col : row) {
-                col.delluminate();
-            }
+        for (auto& square : grid.cells()) {
+            square.delluminate();
         }
     }
 
 public:
 
-    Grid(const std::vector<std::vector<Square>>& grid) : grid{grid} { }
+    explicit Grid(aoc::Grid<Square> grid) : grid{std::move(grid)} { }
 
     void init_illumination_process() {
 
@@ -258,9 +265,7 @@ public:
 
     unsigned no_of_illuminated_squares() const {
         assert(cache.size() != 0 && "Forgot to init_illumination_process()");
-        return std::accumulate(cbegin(grid), cend(grid), size_t{0}, [](size_t acc, const std::vector<Square>& row) {
-            return acc + std::ranges::count_if(row, [](const Square& square){ return square.is_illuminated(); });
-        });
+        return std::ranges::count_if(grid.cells(), [](const Square& square){ return square.is_illuminated(); });
     }
 
     void set_starting_beam(const Beam& b){
@@ -271,9 +276,9 @@ public:
     std::vector<Beam> get_starting_beams() const {
         std::vector<Beam> beams;
 
-        for (gsl::index i = 0; i < grid.size(); ++i) {
-            const gsl::index max_row = gsl::narrow_cast<gsl::index>(grid.size()-1);
-            const gsl::index max_col = gsl::narrow_cast<gsl::index>(grid[0].size()-1);
+        for (gsl::index i = 0; i < grid.height(); ++i) {
+            const gsl::index max_row = gsl::narrow_cast<gsl::index>(grid.height()-1);
+            const gsl::index max_col = gsl::narrow_cast<gsl::index>(grid.width()-1);
 
             beams.emplace_back(Location{i, 0}, Direction::right()); // left edge
             beams.emplace_back(Location{i, max_col}, Direction::left()); // right edge
@@ -290,52 +295,29 @@ public:
 
 bool is_valid_file(std::string_view file_path){
     namespace fs = boost::filesystem;
-    if (!fs::exists(file_path) || !fs::is_regular_file(file_path)) {
+    const fs::path path {std::string(file_path)};
+    if (!fs::exists(path) || !fs::is_regular_file(path)) {
         fmt::print(stderr, "File does not exist or is not a regular file: {}\n", file_path);
         return false;
     }
     return true;
 }
 
-auto tokenize(const std::vector<std::string> &lines_of_data) {
-    std::vector<std::vector<Square>> tokenized_lines_of_data;
-    for (const auto& line : lines_of_data) {
-        const std::vector<Square> tokens = [&](){
-            std::vector<Square> tokens;
-            for (char c : line) {
-                tokens.emplace_back(c);
-            }
-            return tokens;
-        }();
-        tokenized_lines_of_data.push_back(tokens);
-    }
-    return tokenized_lines_of_data;
-}
-
-template<typename T>
-[[nodiscard]] std::vector<T> vectorize(std::ifstream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
-    }
-    return vec;
-}
-
-Grid parse(std::string_view file_path) {
-    assert(is_valid_file(file_path));
-    std::ifstream data(file_path);
-    return Grid{tokenize(vectorize<std::string>(data))};
+Grid parse(std::string_view data) {
+    const aoc::Phase phase {"q16 parse"};
+    return Grid{aoc::Grid<Square>{aoc::grid_view(data), [](char c){ return Square{c}; }}};
 }
 
 // solutions
 
 unsigned part_1(Grid grid) {
+    const aoc::Phase phase {"q16 solve: part_1"};
     grid.init_illumination_process();
     return grid.no_of_illuminated_squares();
 }
 
 unsigned part_2(Grid grid) {
+    const aoc::Phase phase {"q16 solve: part_2"};
     const std::vector<Beam> starting_beams = grid.get_starting_beams();
 
     auto get_illuminated_squares = [&](const Beam& b) -> unsigned {
@@ -349,9 +331,22 @@ unsigned part_2(Grid grid) {
     return *std::ranges::max_element(scores);
 }
 
+aoc::Answer solve_part_1(std::string_view input) {
+    return part_1(parse(input));
+}
+
+aoc::Answer solve_part_2(std::string_view input) {
+    return part_2(parse(input));
+}
+
+}
+
+#ifndef AOC_NO_MAIN
 int main() {
-    Grid grid = parse("../input.txt");
-    fmt::print("Part 1: {}\n", part_1(grid));
-    fmt::print("Part 2: {}\n", part_2(grid));
+    assert(q16::is_valid_file("../input.txt"));
+    const aoc::MappedFile data("../input.txt");
+    fmt::print("Part 1: {}\n", q16::solve_part_1(data.view()));
+    fmt::print("Part 2: {}\n", q16::solve_part_2(data.view()));
     return 0;
-}
\ No newline at end of file
+}
+#endif
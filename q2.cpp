@@ -1,125 +1,383 @@
-#include <cassert>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
 #include <fmt/format.h>
-#include <fstream>
 #include <iostream>
-#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
 
-using std::literals::string_literals::operator""s;
+#include "common/Days.h"
+#include "common/Input.h"
+#include "common/Instrument.h"
 
-// helpers...
+namespace q2 {
 
-template<typename T>
-std::vector<T> vectorize(std::istream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
-    }
-    return vec;
-}
+// colours: the engine is templated on a constexpr list of colour names, so the count struct and the parser's
+// dispatch table are built at compile time for whichever colours a variant of the game uses
 
-int to_int(char c) {
-    assert(isdigit(c,std::locale()));
-    return c - '0';
-}
+template <std::size_t N>
+using Counts = std::array<int, N>; // one count per colour, in the order the names are listed
 
-// the rest...
+constexpr std::array<std::string_view, 3> rgb {"red", "green", "blue"};
 
-enum class Colour {N, RED, GREEN, BLUE};
+using RGB_Count = Counts<rgb.size()>;
 
-struct RGB_Count {
-    int red, green, blue;
-};
+template <std::size_t N>
+bool is_valid(const Counts<N>& hand, const Counts<N>& max) {
+    bool is_within = true;
+    for (std::size_t i = 0; i < N; ++i) {
+        is_within &= max[i] >= hand[i];
+    }
+    return is_within;
+}
 
-void update_rgb(RGB_Count& rgb, Colour colour, int total) {
-    switch (colour) {
-        case Colour::RED: rgb.red = std::max(rgb.red, total); break;
-        case Colour::GREEN: rgb.green = std::max(rgb.green, total); break;
-        case Colour::BLUE: rgb.blue = std::max(rgb.blue, total); break;
-        default: break;
+template <std::size_t N>
+aoc::Answer power(const Counts<N>& hand) {
+    aoc::Answer product = 1;
+    for (const int count : hand) {
+        product *= count;
     }
+    return product;
 }
 
-void reset(int& total, int& multi) {
-    total = 0; multi = 1;
+constexpr bool is_letter(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
 }
 
-// line parser ...
+template <const auto& Names>
+struct ColourSet {
+    /// A trie over the names as a byte-indexed transition table. A colour is settled on the first letter that rules
+    /// out every other name, so with "red", "green" and "blue" that's the first letter, as it always was, and that
+    /// transition leads straight to first_colour + the colour rather than to another state. A name that is a prefix
+    /// of another is settled when its word ends
+    static constexpr std::size_t size = Names.size();
 
-RGB_Count calc_max_of_each_colour(const std::string& line) {
+    static constexpr std::size_t no_of_states = [](){
+        std::size_t n = 2;
+        for (const std::string_view name : Names) n += name.size();
+        return n;
+    }();
+    static_assert(size > 0 && no_of_states + size <= 256, "Too many colours for a byte sized trie state");
 
-    RGB_Count rgb {0, 0, 0};
-    Colour current_colour = Colour::N;
+    static constexpr std::uint8_t root = 0;
+    static constexpr std::uint8_t no_match = 1;
+    static constexpr std::uint8_t first_colour = no_of_states;
 
-    int total = 0, multi = 1;
+    struct Trie {
+        std::array<std::array<std::uint8_t, 256>, no_of_states> next {};
+        std::array<std::int8_t, no_of_states> at_word_end {}; // the colour whose name ends here, else -1
+        bool is_prefix_free = true; // ie. every colour is settled by a letter, so word ends needn't be looked for
+    };
 
-    for (size_t i = line.length() - 1; i != std::numeric_limits<size_t>::max(); --i) { // i == std::numeric_limits<size_t>::max() when underflow.
+    static constexpr Trie trie = [](){
+        Trie t;
+        std::array<int, no_of_states> no_of_names_through {};
+        std::array<std::uint8_t, no_of_states> last_name_through {};
+        for (auto& row : t.next) row.fill(no_match);
+        t.at_word_end.fill(-1);
 
-        const char current = line[i];
+        std::size_t no_of_used_states = 2;
+        for (std::size_t colour = 0; colour < size; ++colour) {
+            const std::string_view name = Names[colour];
+            if (name.empty()) throw std::logic_error("Colour names can't be empty");
+            std::size_t state = root;
+            for (const char c : name) {
+                if (!is_letter(c)) throw std::logic_error("Colour names must be letters only");
+                auto& to = t.next[state][static_cast<unsigned char>(c)];
+                if (to == no_match) to = static_cast<std::uint8_t>(no_of_used_states++);
+                state = to;
+                ++no_of_names_through[state];
+                last_name_through[state] = static_cast<std::uint8_t>(colour);
+            }
+            if (t.at_word_end[state] != -1) throw std::logic_error("Colour names must be distinct");
+            t.at_word_end[state] = static_cast<std::int8_t>(colour);
+        }
+        for (std::size_t state = 0; state < no_of_states; ++state) {
+            if (t.at_word_end[state] != -1 && no_of_names_through[state] > 1) t.is_prefix_free = false;
+        }
+        for (auto& row : t.next) {
+            for (auto& to : row) {
+                if (to != no_match && no_of_names_through[to] == 1) to = first_colour + last_name_through[to];
+            }
+        }
+        return t;
+    }();
+};
+
+// streaming parser ...
 
-        if (current == ':') break;
+enum class CharClass : std::uint8_t {OTHER, DIGIT, COLON, NEWLINE, LETTER};
 
-        if ("0123456789rgb"s.find(current) == std::string::npos) continue;
+constexpr std::array<CharClass, 256> char_classes = [](){
+    std::array<CharClass, 256> classes {};
+    for (char c = '0'; c <= '9'; ++c) classes[static_cast<unsigned char>(c)] = CharClass::DIGIT;
+    for (int c = 0; c < 256; ++c) {
+        if (is_letter(static_cast<char>(c))) classes[static_cast<std::size_t>(c)] = CharClass::LETTER;
+    }
+    classes[':'] = CharClass::COLON;
+    classes['\n'] = CharClass::NEWLINE;
+    return classes;
+}();
+
+template <const auto& Names, typename OnGame>
+class GameParser {
+    /// Reads games forward a chunk at a time, calling on_game(id, maxima) as each game's line ends. Chunks can be
+    /// split anywhere, even mid-number or mid-name, and nothing is buffered, so input of any size streams through in
+    /// constant memory. Games are numbered by line, from 1
+    using Colours = ColourSet<Names>;
 
-        if (isdigit(current)) {
-            total += to_int(current) * multi;
-            multi *= 10;
+    OnGame m_on_game;
+    int m_id = 1;
+    Counts<Colours::size> m_maxima {};
+    int m_count = 0;
+    bool m_has_count = false;
+    std::uint8_t m_word = Colours::root; // how far into a colour name, once a count is waiting for one
+    bool m_is_in_header = true; // ie. still in "Game n", whose digits aren't counts
+    bool m_is_mid_line = false;
+
+    void end_count(int colour) {
+        /// NB: a word that isn't a colour drops its count, as long as it strays from the names before one is settled
+        if (colour >= 0) {
+            m_maxima[static_cast<std::size_t>(colour)] = std::max(m_maxima[static_cast<std::size_t>(colour)], m_count);
         }
-        else if (total != 0) {
-            update_rgb(rgb, current_colour, total);
-            reset(total, multi);
+        m_count = 0;
+        m_has_count = false;
+        m_word = Colours::root;
+    }
+
+    void end_word() {
+        if constexpr (!Colours::trie.is_prefix_free) {
+            if (m_word != Colours::root) end_count(Colours::trie.at_word_end[m_word]);
         }
+    }
+
+    void end_game() {
+        end_word();
+        m_on_game(m_id++, m_maxima);
+        m_maxima = {};
+        m_count = 0;
+        m_has_count = false;
+        m_is_in_header = true;
+        m_is_mid_line = false;
+    }
 
-        switch (current) {
-            case 'r': current_colour = Colour::RED; break;
-            case 'g': current_colour = Colour::GREEN; break;
-            case 'b': current_colour = Colour::BLUE; break;
-            default: break;
+public:
+    explicit GameParser(OnGame on_game) : m_on_game{std::move(on_game)} { }
+
+    void feed(std::string_view chunk) {
+        for (const char c : chunk) {
+            m_is_mid_line = true;
+            switch (char_classes[static_cast<unsigned char>(c)]) {
+                case CharClass::DIGIT:
+                    if (!m_is_in_header) {
+                        m_count = m_count * 10 + (c - '0');
+                        m_has_count = true;
+                    }
+                    break;
+                case CharClass::COLON: m_is_in_header = false; break;
+                case CharClass::NEWLINE: end_game(); break;
+                case CharClass::LETTER:
+                    if (m_has_count) {
+                        const std::uint8_t to = Colours::trie.next[m_word][static_cast<unsigned char>(c)];
+                        if (to >= Colours::first_colour) end_count(to - Colours::first_colour);
+                        else if (to == Colours::no_match) end_count(-1);
+                        else m_word = to;
+                    }
+                    break;
+                case CharClass::OTHER: end_word(); break;
+            }
         }
     }
 
-    update_rgb(rgb, current_colour, total);
-    return rgb;
+    void finish() {
+        /// Like aoc::lines, a last line without its '\n' is still a game
+        if (m_is_mid_line) end_game();
+    }
+};
+
+template <const auto& Names, typename OnGame>
+GameParser<Names, OnGame> make_parser(OnGame on_game) {
+    return GameParser<Names, OnGame>{std::move(on_game)};
 }
 
-bool is_valid(const RGB_Count& hand, const RGB_Count max) {
-    return max.red >= hand.red
-        && max.green >= hand.green
-        && max.blue >= hand.blue;
+// both parts in one pass
+
+struct Totals {
+    aoc::Answer part_1 = 0; // sum of the ids of games possible with the part 1 bag
+    aoc::Answer part_2 = 0; // sum of the powers of each game's fewest cubes
+};
+
+const RGB_Count part_1_bag {12, 13, 14};
+
+auto totals_parser(Totals& totals) {
+    return make_parser<rgb>([&totals](int id, const RGB_Count& min_hand){
+        totals.part_1 += is_valid(min_hand, part_1_bag) ? id : 0;
+        totals.part_2 += power(min_hand);
+    });
 }
 
-int main() {
+Totals calc_totals(std::string_view input) {
+    const aoc::Phase phase {"q2 solve: calc_totals"}; // NB: no parse phase, each game is scored as it's read
+    Totals totals;
+    auto parser = totals_parser(totals);
+    parser.feed(input);
+    parser.finish();
+    return totals;
+}
 
-    std::ifstream data("../data.txt");
-    if (!data.is_open()) {
-        throw std::runtime_error("Unable to open file");
+Totals calc_totals(std::FILE* stream) {
+    /// Reads `stream` to the end in fixed size chunks
+    Totals totals;
+    auto parser = totals_parser(totals);
+    std::array<char, 1 << 16> buffer; // NB: uninitialized, only the bytes read are looked at
+    std::size_t size = 0;
+    while ((size = std::fread(buffer.data(), 1, buffer.size(), stream)) > 0) {
+        parser.feed({buffer.data(), size});
+    }
+    if (std::ferror(stream)) {
+        throw std::runtime_error("Unable to read input");
     }
-    
-    std::vector<std::string> lines = vectorize<std::string>(data);
+    parser.finish();
+    return totals;
+}
 
-    const int part_1 = [&](){
+// columnar store and bag queries
 
-        const RGB_Count no_of_cubes {12, 13, 14};
+template <std::size_t N>
+struct GameColumns {
+    /// Each game's fewest cubes of each colour, column by column. Game i has id i + 1
+    std::array<std::vector<int>, N> columns;
 
-        int sum_of_indices = 0;
-        for (size_t i = 0; i < lines.size(); ++i) {
-            const RGB_Count min_hand = calc_max_of_each_colour(lines[i]);
-            sum_of_indices += is_valid(min_hand, no_of_cubes) ? static_cast<int>(i + 1) : 0;
+    [[nodiscard]] std::size_t size() const { return columns[0].size(); }
+};
+
+template <const auto& Names>
+GameColumns<Names.size()> read_columns(std::string_view input) {
+    GameColumns<Names.size()> games;
+    auto parser = make_parser<Names>([&games](int, const Counts<Names.size()>& min_hand){
+        for (std::size_t i = 0; i < min_hand.size(); ++i) {
+            games.columns[i].push_back(min_hand[i]);
         }
-        return sum_of_indices;
+    });
+    parser.feed(input);
+    parser.finish();
+    return games;
+}
 
-    }();
+template <std::size_t N>
+class BagQueries {
+    /// Sum of the ids of the games possible with a given bag, for any number of bags. When the largest counts are
+    /// small, as they are in practice, an N-D prefix sum over the colours answers each bag with one lookup: cell
+    /// (c0, c1, ...) holds the ids of every game needing no more than c0 of the first colour, c1 of the second and
+    /// so on. Otherwise each bag is a branchless scan down the columns
+    static constexpr std::size_t max_table_size = std::size_t{1} << 21;
 
-    const int part_2 = [&](){
-        return std::accumulate(cbegin(lines), cend(lines), 0, [&](int acc, const std::string& line){
-            const RGB_Count min_hand = calc_max_of_each_colour(line);
-            const int power = min_hand.red * min_hand.green * min_hand.blue;
-            return acc + power;
-        });
-    }();
+    const GameColumns<N>& m_games;
+    std::array<std::size_t, N> m_dims {}; // largest count of each colour + 1
+    std::array<std::size_t, N> m_strides {};
+    std::vector<aoc::Answer> m_table;
+
+    void build_table() {
+        for (std::size_t i = 0; i < m_games.size(); ++i) {
+            std::size_t ix = 0;
+            for (std::size_t c = 0; c < N; ++c) {
+                ix += static_cast<std::size_t>(m_games.columns[c][i]) * m_strides[c];
+            }
+            m_table[ix] += static_cast<aoc::Answer>(i + 1);
+        }
+        /// Summing along each axis in turn leaves every cell holding the sum of the box below it
+        for (std::size_t c = 0; c < N; ++c) {
+            for (std::size_t ix = 0; ix < m_table.size(); ++ix) {
+                if ((ix / m_strides[c]) % m_dims[c] > 0) m_table[ix] += m_table[ix - m_strides[c]];
+            }
+        }
+    }
+
+    [[nodiscard]] aoc::Answer scan(const Counts<N>& bag) const {
+        aoc::Answer sum = 0;
+        for (std::size_t i = 0; i < m_games.size(); ++i) {
+            bool is_possible = true;
+            for (std::size_t c = 0; c < N; ++c) {
+                is_possible &= m_games.columns[c][i] <= bag[c];
+            }
+            sum += is_possible ? static_cast<aoc::Answer>(i + 1) : 0;
+        }
+        return sum;
+    }
+
+public:
+    explicit BagQueries(const GameColumns<N>& games) : m_games{games} {
+        std::size_t table_size = 1;
+        for (std::size_t c = N; c-- > 0;) {
+            const auto& column = games.columns[c];
+            m_dims[c] = column.empty() ? 1 : static_cast<std::size_t>(*std::ranges::max_element(column)) + 1;
+            m_strides[c] = table_size;
+            table_size = table_size > max_table_size ? table_size : table_size * m_dims[c];
+        }
+        if (table_size <= max_table_size) {
+            m_table.assign(table_size, 0);
+            build_table();
+        }
+    }
+
+    [[nodiscard]] aoc::Answer sum_of_possible_ids(const Counts<N>& bag) const {
+        if (m_table.empty()) return scan(bag);
+        std::size_t ix = 0;
+        for (std::size_t c = 0; c < N; ++c) {
+            if (bag[c] < 0) return 0;
+            ix += std::min(static_cast<std::size_t>(bag[c]), m_dims[c] - 1) * m_strides[c];
+        }
+        return m_table[ix];
+    }
+
+    [[nodiscard]] std::vector<aoc::Answer> sum_of_possible_ids(std::span<const Counts<N>> bags) const {
+        std::vector<aoc::Answer> sums;
+        sums.reserve(bags.size());
+        for (const Counts<N>& bag : bags) {
+            sums.push_back(sum_of_possible_ids(bag));
+        }
+        return sums;
+    }
+};
+
+aoc::Answer solve_part_1(std::string_view input) {
+    return calc_totals(input).part_1;
+}
+
+aoc::Answer solve_part_2(std::string_view input) {
+    return calc_totals(input).part_2;
+}
+
+}
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char** argv) {
+    /// `q2 -` streams the games from stdin instead.
+    /// `q2 <red>,<green>,<blue>...` prints the sum of the ids of the games possible with each of those bags
+    const bool is_from_stdin = argc > 1 && std::string_view{argv[1]} == "-";
+    if (argc > 1 && !is_from_stdin) {
+        const aoc::MappedFile data("../data.txt");
+        const auto games = q2::read_columns<q2::rgb>(data.view());
+        const q2::BagQueries queries {games};
+        for (int i = 1; i < argc; ++i) {
+            q2::RGB_Count bag {};
+            if (std::sscanf(argv[i], "%d,%d,%d", &bag[0], &bag[1], &bag[2]) != 3) {
+                throw std::invalid_argument("Expected <red>,<green>,<blue>");
+            }
+            fmt::print("{}: {}\n", argv[i], queries.sum_of_possible_ids(bag));
+        }
+        return 0;
+    }
+
+    const q2::Totals totals = is_from_stdin ? q2::calc_totals(stdin) : q2::calc_totals(aoc::MappedFile("../data.txt").view());
 
-    fmt::print("Part 1: {}\n", part_1);
-    fmt::print("Part 2: {}\n", part_2);
+    fmt::print("Part 1: {}\n", totals.part_1);
+    fmt::print("Part 2: {}\n", totals.part_2);
 
     return 0;
 }
+#endif
@@ -1,140 +1,221 @@
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
 #include <fmt/format.h>
-#include <fstream>
 #include <iostream>
+#include <memory>
 #include <numeric>
-#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
-using Iter = std::string::const_iterator;
+#include "common/Days.h"
+#include "common/Input.h"
+#include "common/Instrument.h"
 
-struct NeighbourInfo {
-    bool has_neighbour;
-    std::set<std::pair<size_t, size_t>> gear_locations{};
-};
+namespace q3 {
+
+using Lines = std::vector<std::string_view>;
 
 struct NumData {
     int num;
     bool is_valid;
-    NeighbourInfo neighbour_info;
 };
 
+struct Gear {
+    int no_of_numbers = 0;
+    aoc::Answer product = 1;
+};
+
+using GearTable = std::unordered_map<size_t, Gear>; // keyed by flat cell index, ie. row * no. of cols + col
+
 bool is_symbol(char c){
     return !isdigit(c) && c != '.';
 }
 
-std::pair<int, int> clamp_ixs(std::pair<size_t, size_t> row_col, std::pair<size_t, size_t> row_col_sizes) {
-    return {std::clamp(static_cast<int>(row_col.first), 0, static_cast<int>(row_col_sizes.first-1))
-    , std::clamp(static_cast<int>(row_col.second), 0, static_cast<int>(row_col_sizes.second-1))};
-}
+// bitmasks: one bit per cell, so a number's neighbourhood is a few word-wise ANDs rather than a lookup per cell
 
-NeighbourInfo get_neighbour_info(const std::vector<std::string>& lines, size_t row, size_t col) {
+using Word = std::uint64_t;
+constexpr size_t word_bits = 64;
 
-    NeighbourInfo ni {.has_neighbour = false};
+class BitGrid {
+    /// Each row padded to whole words
+    size_t m_no_of_rows;
+    size_t m_words_per_row;
+    std::vector<Word> m_words;
 
-    for (int col_delta = -1; col_delta <= 1; ++col_delta) {
-        for (int row_delta = -1; row_delta <= 1; ++row_delta) {
+public:
+    BitGrid(size_t no_of_rows, size_t no_of_cols)
+        : m_no_of_rows{no_of_rows}
+        , m_words_per_row{(no_of_cols + word_bits - 1) / word_bits}
+        , m_words(no_of_rows * m_words_per_row, 0) { }
 
-            const auto& [clamped_row, clamped_col]
-                = clamp_ixs({row+row_delta, col+col_delta}, {lines.size(), lines[0].size()});
+    [[nodiscard]] size_t no_of_rows() const { return m_no_of_rows; }
+    [[nodiscard]] size_t words_per_row() const { return m_words_per_row; }
+    [[nodiscard]] std::span<Word> row(size_t r) { return {m_words.data() + r * m_words_per_row, m_words_per_row}; }
+    [[nodiscard]] std::span<const Word> row(size_t r) const { return {m_words.data() + r * m_words_per_row, m_words_per_row}; }
 
-            if (clamped_row - row == 0 && clamped_col - col == 0) {
-                continue;
-            }
+    void set(size_t r, size_t c) {
+        row(r)[c / word_bits] |= Word{1} << (c % word_bits);
+    }
+};
 
-            if (is_symbol(lines[clamped_row][clamped_col])) {
-                ni.has_neighbour = true;
-                if (lines[clamped_row][clamped_col] == '*') {
-                    ni.gear_locations.insert({clamped_row, clamped_col});
-                }
-            }
+[[nodiscard]] Word span_mask(size_t word_ix, size_t begin, size_t end) {
+    /// The bits of word `word_ix` that fall in columns [begin, end)
+    const size_t word_begin = word_ix * word_bits;
+    const size_t lo = std::max(begin, word_begin) - word_begin;
+    const size_t hi = std::min(end, word_begin + word_bits) - word_begin;
+    const Word below_hi = (hi == word_bits) ? ~Word{0} : (Word{1} << hi) - 1;
+    return below_hi & ~((Word{1} << lo) - 1);
+}
 
-        }
+[[nodiscard]] bool any_in(std::span<const Word> row, size_t begin, size_t end) {
+    /// Whether any of columns [begin, end) is set
+    for (size_t w = begin / word_bits; w * word_bits < end; ++w) {
+        if (row[w] & span_mask(w, begin, end)) return true;
     }
-
-    return ni;
+    return false;
 }
 
-Iter pos_of_first_digit(Iter pos, const std::string& line) {
-    /// return iter to first digit from `pos` (inclusive)
-    if (pos == cend(line)) return pos;
-    return std::find_if(pos, cend(line), [](const char c) {
-        return std::isdigit(c);
-    });
+[[nodiscard]] size_t next_col(std::span<const Word> row, size_t from, bool is_set) {
+    /// First column from `from` (inclusive) whose bit is `is_set`, or the padded width if there's none
+    const Word flip = is_set ? 0 : ~Word{0};
+    for (size_t w = from / word_bits; w < row.size(); ++w) {
+        const Word from_mask = (w == from / word_bits) ? ~Word{0} << (from % word_bits) : ~Word{0};
+        const Word bits = (row[w] ^ flip) & from_mask;
+        if (bits) return w * word_bits + static_cast<size_t>(std::countr_zero(bits));
+    }
+    return row.size() * word_bits;
 }
 
-Iter pos_of_first_non_digit(Iter pos, const std::string& line) {
-    /// return iter to first non-digit from `pos` (inclusive)
-    if (pos == cend(line)) return pos;
-    return std::find_if_not(pos, cend(line), [](const char c){
-        return std::isdigit(c);
-    });
+[[nodiscard]] Word spread_across(std::span<const Word> row, size_t w) {
+    /// Word `w` of `row` with each set cell spread to its left and right
+    const Word carry_in_from_left = (w > 0) ? row[w - 1] >> (word_bits - 1) : 0;
+    const Word carry_in_from_right = (w + 1 < row.size()) ? row[w + 1] << (word_bits - 1) : 0;
+    return row[w] | row[w] << 1 | row[w] >> 1 | carry_in_from_left | carry_in_from_right;
 }
 
-int num_from_iter_range(Iter start, Iter finish){
-    ///      . . 4 3 2 5 % . .
-    /// it:      ^       ^
-    int num = 0;
-    for (auto it = start; it < finish; ++it) {
-        num = num * 10 + (*it - '0');
+[[nodiscard]] BitGrid dilate(const BitGrid& cells) {
+    /// Each set cell spread over its 8 neighbours: left and right within the row, then up and down between rows
+    const size_t no_of_rows = cells.no_of_rows();
+    const size_t no_of_words = cells.words_per_row();
+
+    BitGrid across = cells;
+    for (size_t r = 0; r < no_of_rows; ++r) {
+        const auto out = across.row(r);
+        for (size_t w = 0; w < no_of_words; ++w) {
+            out[w] = spread_across(cells.row(r), w);
+        }
     }
-    return num;
-}
 
-NumData build_numdata_entry(Iter pos, Iter end_pos, const std::vector<std::string>& lines, size_t r_ix) {
+    BitGrid spread = across;
+    for (size_t r = 0; r < no_of_rows; ++r) {
+        const auto out = spread.row(r);
+        for (size_t w = 0; w < no_of_words; ++w) {
+            if (r > 0) out[w] |= across.row(r - 1)[w];
+            if (r + 1 < no_of_rows) out[w] |= across.row(r + 1)[w];
+        }
+    }
+    return spread;
+}
 
-    const auto& current_row = lines[r_ix];
+struct Schematic {
+    /// The rows plus masks of their digits, their gears ('*'), every cell next to a symbol and every cell next to a gear
+    const Lines& lines;
+    size_t no_of_cols;
+    size_t no_of_gears;
+    BitGrid digits, gears, near_symbol, near_gear;
+};
 
-    bool is_valid = [&](){
-        for (auto p = pos; p < end_pos; ++p) {
-            const size_t c_ix = std::distance(cbegin(current_row), p);
-            const NeighbourInfo info = get_neighbour_info(lines, r_ix, c_ix);
-            if (info.has_neighbour) {
-                return true;
+Schematic read_schematic(const Lines& lines) {
+    const size_t no_of_cols = std::ranges::max(lines, {}, &std::string_view::size).size();
+
+    BitGrid digits {lines.size(), no_of_cols};
+    BitGrid symbols {lines.size(), no_of_cols};
+    BitGrid gears {lines.size(), no_of_cols};
+    size_t no_of_gears = 0;
+    for (size_t r = 0; r < lines.size(); ++r) {
+        for (size_t c = 0; c < lines[r].size(); ++c) {
+            const char ch = lines[r][c];
+            if (isdigit(ch)) digits.set(r, c);
+            else if (is_symbol(ch)) symbols.set(r, c);
+            if (ch == '*') {
+                gears.set(r, c);
+                ++no_of_gears;
             }
         }
-        return false;
-    }();
-
-    const std::set<std::pair<size_t, size_t>> gear_locations = [&](){
-        std::set<std::pair<size_t, size_t>> gl;
-        for (auto p = pos; p < end_pos; ++p) {
-            const size_t c_ix = std::distance(cbegin(current_row), p);
-            const NeighbourInfo info = get_neighbour_info(lines, r_ix, c_ix);
-            gl.insert(cbegin(info.gear_locations), cend(info.gear_locations));
-        }
-        return gl;
-    }();
+    }
 
-    const NumData entry {
-        .num = num_from_iter_range(pos, end_pos),
-        .is_valid = is_valid,
-        .neighbour_info = {is_valid, gear_locations}
-    };
+    BitGrid near_symbol = dilate(symbols);
+    BitGrid near_gear = dilate(gears);
+    return {lines, no_of_cols, no_of_gears, std::move(digits), std::move(gears), std::move(near_symbol), std::move(near_gear)};
+}
 
-    return entry;
+int num_from_range(std::string_view row, size_t start, size_t finish){
+    ///      . . 4 3 2 5 % . .
+    /// ix:      ^       ^
+    int num = 0;
+    for (size_t ix = start; ix < finish; ++ix) {
+        num = num * 10 + (row[ix] - '0');
+    }
+    return num;
 }
 
-std::vector<NumData> extract_num_data(const std::vector<std::string>& lines) {
+void add_to_gears(std::span<const Word> gear_row, size_t r, size_t no_of_cols, size_t start, size_t finish, int num,
+                  GearTable& gears) {
+    /// Counts `num`, spanning columns [start, finish) of a row next to row `r`, towards the '*'s of row `r` around it
+    const size_t first_col = (start == 0) ? 0 : start - 1;
+    for (size_t w = first_col / word_bits; w * word_bits <= finish && w < gear_row.size(); ++w) {
+        Word bits = gear_row[w] & span_mask(w, first_col, finish + 1);
+        for (; bits; bits &= bits - 1) {
+            const size_t c = w * word_bits + static_cast<size_t>(std::countr_zero(bits));
+            Gear& gear = gears[r * no_of_cols + c];
+            ++gear.no_of_numbers;
+            gear.product *= num;
+        }
+    }
+}
 
+std::vector<NumData> extract_num_data(const Lines& lines, GearTable& gears) {
+    /// Every number in the schematic, counting each towards the gears next to it as it's found
+    const aoc::Phase phase {"q3 solve: extract_num_data"};
     std::vector<NumData> num_data;
+    if (lines.empty()) return num_data;
+
+    const Schematic schematic = read_schematic(lines);
+    gears.reserve(schematic.no_of_gears);
 
     for (size_t r_ix = 0; r_ix < lines.size(); ++r_ix) {
 
-        const std::string& current_row = lines[r_ix];
-        std::string::const_iterator pos = cbegin(current_row), end_pos;
+        const std::string_view current_row = lines[r_ix];
+        const auto digits = schematic.digits.row(r_ix);
 
-        while (pos != cend(current_row)) {
+        for (size_t pos = next_col(digits, 0, true); pos < current_row.size(); ) {
 
-            pos = pos_of_first_digit(pos, current_row);
-            end_pos = pos_of_first_non_digit(pos, current_row);
+            const size_t end_pos = next_col(digits, pos, false);
 
-            const NumData entry = build_numdata_entry(pos, end_pos, lines, r_ix);
+            const NumData entry {
+                .num = num_from_range(current_row, pos, end_pos),
+                .is_valid = any_in(schematic.near_symbol.row(r_ix), pos, end_pos)
+            };
 
             if (entry.num != 0) {
                 num_data.push_back(entry);
+                if (any_in(schematic.near_gear.row(r_ix), pos, end_pos)) {
+                    const size_t first_row = (r_ix == 0) ? 0 : r_ix - 1;
+                    const size_t last_row = std::min(r_ix + 1, lines.size() - 1);
+                    for (size_t r = first_row; r <= last_row; ++r) {
+                        add_to_gears(schematic.gears.row(r), r, schematic.no_of_cols, pos, end_pos, entry.num, gears);
+                    }
+                }
             }
 
-            pos = (end_pos == cend(current_row)) ? cend(current_row) : end_pos + 1;
+            pos = next_col(digits, end_pos, true);
         }
 
     }
@@ -142,58 +223,185 @@ std::vector<NumData> extract_num_data(const std::vector<std::string>& lines) {
     return num_data;
 }
 
-std::vector<NumData> extract_ordered_num_data(const std::vector<std::string>& data) {
-    std::vector<NumData> n = extract_num_data(data);
-    std::sort(begin(n), end(n), [&](const NumData& a, const NumData& b){
-        return a.neighbour_info.gear_locations < b.neighbour_info.gear_locations;
+aoc::Answer solve_part_1(std::string_view input) {
+    GearTable gears;
+    const std::vector<NumData> nums = extract_num_data(aoc::lines(input), gears);
+    const aoc::Phase phase {"q3 solve: sum part numbers"};
+    return std::accumulate(cbegin(nums), cend(nums), aoc::Answer{0}, [&](aoc::Answer acc, const NumData& nd) {
+        const int val = nd.is_valid ? nd.num : 0;
+        return acc + val;
     });
-    return n;
 }
 
-template<typename T>
-std::vector<T> vectorize(std::ifstream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
-    }
-    return vec;
+aoc::Answer solve_part_2(std::string_view input) {
+    /// A gear is a '*' next to exactly two numbers
+    GearTable gears;
+    extract_num_data(aoc::lines(input), gears);
+    const aoc::Phase phase {"q3 solve: sum gear ratios"};
+    return std::accumulate(cbegin(gears), cend(gears), aoc::Answer{0}, [](aoc::Answer acc, const auto& cell_and_gear) {
+        const Gear& gear = cell_and_gear.second;
+        return acc + (gear.no_of_numbers == 2 ? gear.product : 0);
+    });
 }
 
-int main() {
+// streaming: a rolling three row window, as a row's numbers only ever touch the rows either side of it
+
+struct Totals {
+    aoc::Answer part_1 = 0; // sum of the part numbers
+    aoc::Answer part_2 = 0; // sum of the gear ratios
+};
+
+class SchematicStream {
+    /// Reads a schematic forward a chunk at a time. A row is retired, ie. its numbers are counted, once the row after
+    /// it has been read, and a row's gears are settled once the row after it has been retired, so only the last three
+    /// rows and the gears among them are ever held: memory is O(width) however many rows there are
+    struct Row {
+        std::string text;
+        std::vector<Word> digits, symbols, gears;
+    };
 
-    std::ifstream data("../data.txt");
-    if (!data.is_open()) {
-        throw std::runtime_error("Unable to open file");
+    std::array<Row, 3> m_window; // row r is in m_window[r % 3]
+    size_t m_no_of_rows = 0; // read so far
+    size_t m_no_of_cols = 0; // of the first row, which no other row may be wider than
+    std::string m_partial; // the start of a row split across chunks
+    std::vector<Word> m_near_symbol, m_near_gear; // of the row being retired
+    GearTable m_gears;
+    Totals m_totals;
+
+    Row& row(size_t r) { return m_window[r % 3]; }
+
+    void read_row(std::string_view text) {
+        if (m_no_of_rows == 0) m_no_of_cols = text.size();
+        if (text.size() > m_no_of_cols) {
+            throw std::runtime_error("Unable to stream a schematic with a row wider than its first");
+        }
+        const size_t no_of_words = (m_no_of_cols + word_bits - 1) / word_bits;
+
+        Row& new_row = row(m_no_of_rows);
+        new_row.text.assign(text);
+        for (auto* mask : {&new_row.digits, &new_row.symbols, &new_row.gears}) {
+            mask->assign(no_of_words, 0);
+        }
+        for (size_t c = 0; c < text.size(); ++c) {
+            const Word bit = Word{1} << (c % word_bits);
+            if (isdigit(text[c])) new_row.digits[c / word_bits] |= bit;
+            else if (is_symbol(text[c])) new_row.symbols[c / word_bits] |= bit;
+            if (text[c] == '*') new_row.gears[c / word_bits] |= bit;
+        }
+
+        if (++m_no_of_rows >= 2) retire(m_no_of_rows - 2);
     }
 
-    const std::vector<NumData> nums = [&](){
-        const std::vector<std::string> lines = vectorize<std::string>(data);
-        return extract_ordered_num_data(lines);
-    }();
+    void retire(size_t r) {
+        const size_t first_row = (r == 0) ? 0 : r - 1;
+        const size_t last_row = std::min(r + 1, m_no_of_rows - 1);
+
+        const size_t no_of_words = row(r).digits.size();
+        m_near_symbol.assign(no_of_words, 0);
+        m_near_gear.assign(no_of_words, 0);
+        for (size_t n = first_row; n <= last_row; ++n) {
+            for (size_t w = 0; w < no_of_words; ++w) {
+                m_near_symbol[w] |= spread_across(row(n).symbols, w);
+                m_near_gear[w] |= spread_across(row(n).gears, w);
+            }
+        }
 
-    const int part_1 = std::accumulate(cbegin(nums), cend(nums), 0, [&](int acc, const NumData& nd) {
-        const int val = nd.is_valid ? nd.num : 0;
-        return acc + val;
-    });
+        const Row& current_row = row(r);
+        for (size_t pos = next_col(current_row.digits, 0, true); pos < current_row.text.size(); ) {
+            const size_t end_pos = next_col(current_row.digits, pos, false);
+            const int num = num_from_range(current_row.text, pos, end_pos);
+            if (num != 0) {
+                m_totals.part_1 += any_in(m_near_symbol, pos, end_pos) ? num : 0;
+                if (any_in(m_near_gear, pos, end_pos)) {
+                    for (size_t n = first_row; n <= last_row; ++n) {
+                        add_to_gears(row(n).gears, n, m_no_of_cols, pos, end_pos, num, m_gears);
+                    }
+                }
+            }
+            pos = next_col(current_row.digits, end_pos, true);
+        }
 
-    const int part_2 = [&](){
-        int running_total = 0;
+        if (r > 0) settle_gears(r - 1);
+    }
 
-        const auto start = std::find_if_not(cbegin(nums), cend(nums), [&](const auto& n){
-            return n.neighbour_info.gear_locations.empty();
-        });
+    void settle_gears(size_t r) {
+        /// Every number next to row r's gears has been counted, so they can be summed and forgotten
+        const auto& gear_row = row(r).gears;
+        for (size_t w = 0; w < gear_row.size(); ++w) {
+            for (Word bits = gear_row[w]; bits; bits &= bits - 1) {
+                const auto it = m_gears.find(r * m_no_of_cols + w * word_bits + static_cast<size_t>(std::countr_zero(bits)));
+                if (it == m_gears.end()) continue;
+                m_totals.part_2 += (it->second.no_of_numbers == 2) ? it->second.product : 0;
+                m_gears.erase(it);
+            }
+        }
+    }
 
-        for (auto it = start; it < cend(nums) - 1; ++it) {
-            if (it->neighbour_info.gear_locations == (it+1)->neighbour_info.gear_locations) {
-                running_total += (it->num * (it+1)->num);
+public:
+    void feed(std::string_view chunk) {
+        while (!chunk.empty()) {
+            const auto newline = chunk.find('\n');
+            if (newline == std::string_view::npos) {
+                m_partial.append(chunk);
+                return;
+            }
+            if (m_partial.empty()) {
+                read_row(chunk.substr(0, newline));
+            }
+            else {
+                m_partial.append(chunk.substr(0, newline));
+                read_row(m_partial);
+                m_partial.clear();
             }
+            chunk.remove_prefix(newline + 1);
         }
-        return running_total;
-    }();
+    }
+
+    Totals finish() {
+        /// Like aoc::lines, a last row without its '\n' is still a row
+        if (!m_partial.empty()) {
+            read_row(m_partial);
+            m_partial.clear();
+        }
+        if (m_no_of_rows > 0) {
+            retire(m_no_of_rows - 1);
+            settle_gears(m_no_of_rows - 1);
+        }
+        return m_totals;
+    }
+};
+
+Totals calc_totals(std::FILE* stream, std::size_t chunk_size = 1 << 16) {
+    /// Reads `stream` to the end, `chunk_size` bytes at a time
+    SchematicStream schematic;
+    const auto buffer = std::make_unique_for_overwrite<char[]>(chunk_size); // NB: only the bytes read are looked at
+    std::size_t size = 0;
+    while ((size = std::fread(buffer.get(), 1, chunk_size, stream)) > 0) {
+        schematic.feed({buffer.get(), size});
+    }
+    if (std::ferror(stream)) {
+        throw std::runtime_error("Unable to read input");
+    }
+    return schematic.finish();
+}
+
+}
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char** argv) {
+    /// `q3 -` streams the schematic from stdin instead
+    if (argc > 1 && std::string_view{argv[1]} == "-") {
+        const q3::Totals totals = q3::calc_totals(stdin);
+        fmt::print("Part 1: {}\n", totals.part_1);
+        fmt::print("Part 2: {}\n", totals.part_2);
+        return 0;
+    }
+
+    const aoc::MappedFile data("../data.txt");
 
-    fmt::print("Part 1: {}\n", part_1);
-    fmt::print("Part 2: {}\n", part_2);
+    fmt::print("Part 1: {}\n", q3::solve_part_1(data.view()));
+    fmt::print("Part 2: {}\n", q3::solve_part_2(data.view()));
 
     return 0;
 }
+#endif
@@ -1,165 +1,189 @@
-#include <boost/algorithm/string/classification.hpp> // for boost::is_any_of
-#include <boost/algorithm/string/split.hpp> // for boost::split
-#include <cassert>
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstdint>
 #include <fmt/format.h>
-#include <fstream>
 #include <iostream>
-#include <map>
+#include <limits>
+#include <memory_resource>
 #include <numeric>
-
-using IntVec = std::vector<int>;
-using StrVec = std::vector<std::string>;
-using Card = std::pair<IntVec, IntVec>;
-using CardWithStrVals = std::pair<StrVec, StrVec>;
-
-// type conversions
-
-template<typename T>
-std::vector<T> vectorize(std::istream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
+#include <stdexcept>
+#include <string_view>
+
+#include "common/Arena.h"
+#include "common/Days.h"
+#include "common/Input.h"
+#include "common/Instrument.h"
+
+namespace q4 {
+
+// packed cards: each side of a card as a bitset of its numbers, so a card's matches are one popcount of an AND
+
+using Word = std::uint64_t;
+constexpr size_t word_bits = 64;
+constexpr size_t max_card_number = 65535; // NB: caps a set at 1024 words, so one stray number can't blow up every card
+
+struct PackedCards {
+    /// Card i's winning numbers are the words_per_set words from 2i * words_per_set of `bits`, your numbers the
+    /// words_per_set after. Sets are as wide as the input's largest number needs: two words, 0-127, for real cards
+    size_t words_per_set = 2;
+    std::pmr::vector<Word> bits {aoc::scratch()};
+
+    [[nodiscard]] size_t size() const { return bits.size() / (2 * words_per_set); }
+    [[nodiscard]] const Word* winning(size_t i) const { return bits.data() + 2 * i * words_per_set; }
+    [[nodiscard]] const Word* yours(size_t i) const { return winning(i) + words_per_set; }
+};
+
+void widen(PackedCards& cards, size_t words_per_set) {
+    /// Re-lays the sets read so far out at the new width
+    std::pmr::vector<Word> bits(2 * cards.size() * words_per_set, 0, aoc::scratch());
+    bits.reserve(cards.bits.capacity() / cards.words_per_set * words_per_set);
+    for (size_t set = 0; set < 2 * cards.size(); ++set) {
+        std::copy_n(cards.bits.data() + set * cards.words_per_set, cards.words_per_set, bits.data() + set * words_per_set);
     }
-    return vec;
+    cards.bits = std::move(bits);
+    cards.words_per_set = words_per_set;
 }
 
-std::vector<StrVec> tokenize(const StrVec& lines_of_data) {
-    std::vector<StrVec> tokenized_lines_of_data;
-    for (const auto& line : lines_of_data) {
-        StrVec tokens;
-        boost::split(tokens, line, boost::is_any_of(" "), boost::token_compress_on);
-        tokenized_lines_of_data.push_back(tokens);
+PackedCards parse(std::string_view data) {
+    /// Unaltered input data --> packed cards, in one pass over the buffer
+    /// eg. "Card 1: 41 48 | 83 86 17" --> {41, 48} and {83, 86, 17} as bitsets
+    /// NB: the bits are reserved up front, so there are no allocations per card, unless a card's numbers are too big
+    /// for the sets so far, in which case they're widened
+    const aoc::Phase phase {"q4 parse: PackedCards"};
+    PackedCards cards;
+    cards.bits.reserve(2 * cards.words_per_set * static_cast<size_t>(std::ranges::count(data, '\n') + 1));
+
+    while (!data.empty()) {
+        const std::string_view line = aoc::next_line(data);
+        if (line.empty()) continue;
+
+        const size_t card = cards.size();
+        cards.bits.resize(cards.bits.size() + 2 * cards.words_per_set, 0);
+        size_t side = 0; // 0 for the winning numbers, 1 for yours
+
+        const char* pos = line.data() + line.find(':') + 1; // NB: npos + 1 == 0, ie. a line with no "Card n:"
+        const char* const end = line.data() + line.size();
+        while (pos < end) {
+            if (*pos == '|') {
+                side = 1;
+                ++pos;
+                continue;
+            }
+            if (*pos < '0' || *pos > '9') {
+                ++pos;
+                continue;
+            }
+            size_t n = 0;
+            pos = std::from_chars(pos, end, n).ptr;
+            if (n > max_card_number) {
+                throw std::runtime_error(fmt::format("Unable to pack card number {}, the most is {}", n, max_card_number));
+            }
+            if (n / word_bits >= cards.words_per_set) {
+                widen(cards, std::max(2 * cards.words_per_set, n / word_bits + 1));
+            }
+            Word* set = cards.bits.data() + (2 * card + side) * cards.words_per_set;
+            set[n / word_bits] |= Word{1} << (n % word_bits);
+        }
     }
-    return tokenized_lines_of_data;
+    return cards;
 }
 
-IntVec str_to_int_vec(const StrVec& vec) {
-    IntVec i_vec;
-    for (auto& num : vec) {
-        i_vec.push_back(stoi(num));
-    }
-    return i_vec;
-}
+// calc functions
 
-bool is_num_token(std::string_view token) {
-    /// helper function for split_str_vec()
-    return std::ranges::all_of(token, isdigit);
-}
+// scores and card counts double with every match, so the answers saturate: past what an aoc::Answer can hold, they're
+// its largest value rather than wrapping or throwing
 
-CardWithStrVals split_str_vec(const StrVec& vec) {
-    const auto it = std::ranges::find_if_not(vec, is_num_token);
-    const StrVec part1 = std::vector(cbegin(vec), it);
-    const StrVec part2 = std::vector(it+1, cend(vec));
-    return {part1, part2};
-}
+constexpr aoc::Answer max_answer = std::numeric_limits<aoc::Answer>::max();
 
-void remove_leading_n_elements_from_each_sub_vector(std::vector<StrVec>& vec, size_t n) {
-    /// helper function for convert_data()
-    for (auto& sub_vec : vec) {
-        sub_vec.erase(begin(sub_vec), begin(sub_vec) + static_cast<int>(n));
-    }
+aoc::Answer saturating_add(aoc::Answer a, aoc::Answer b) {
+    /// NB: for non-negative a and b
+    return (b > max_answer - a) ? max_answer : a + b;
 }
 
-std::vector<Card> convert_data(std::ifstream& data) {
-    /// Unaltered input data --> vector of cards
-    /// Each vector element is a card, a card is a pair of {winning nums, your nums}, respectively
-
-    // -> [line{strA,strA2,strA3,strA4,...,strAn}, ..., lineN{strN,strN2,strN3,strN4,...,strNn}]
-    // eg. line: {"84", "73", "|", "24", "20"}
-    const std::vector<StrVec> tokenized_lines_of_data = [&](){
-        std::vector<std::string> lines_of_data = vectorize<std::string>(data);
-        std::vector<StrVec> tokenized_lines_of_data = tokenize(lines_of_data);
-        remove_leading_n_elements_from_each_sub_vector(tokenized_lines_of_data, 2);
-        return tokenized_lines_of_data;
-    }();
-
-    // convert data to str cards
-    // -> [{StrVec0, StrVec'0}, ..., {StrVecn, StrVec'n}]
-    const std::vector<CardWithStrVals> split_vec = [&tokenized_lines_of_data](){
-        std::vector<CardWithStrVals> vec;
-        for (auto& str_vec : tokenized_lines_of_data) {
-            vec.push_back(split_str_vec(str_vec));
-        }
-        return vec;
-    }();
-
-    // convert str cards to `Card`s
-    // -> [{IntVec0, IntVec'0}, ..., {IntVecn, IntVec'n}]
-    const std::vector<Card> winning_and_your_numbers = [&](){
-        std::vector<Card> w;
-        for (const auto& str_vec_pair : split_vec) {
-            w.emplace_back(str_to_int_vec(str_vec_pair.first), str_to_int_vec(str_vec_pair.second));
-        }
-        return w;
-    }();
-
-    return winning_and_your_numbers;
-}
-
-// calc functions
-
-int calc_card_score(int no_of_matches) {
+aoc::Answer calc_card_score(int no_of_matches) {
     if (no_of_matches == 0) return 0;
-    return 1 << (no_of_matches-1); // == 1 ^ no_of_matches
+    if (no_of_matches > 63) return max_answer; // NB: 2 ^ 63 is already one more than the most an Answer holds
+    return aoc::Answer{1} << (no_of_matches-1); // == 2 ^ (no_of_matches - 1)
 }
 
-int calc_card_matches(const Card& card) {
-    const IntVec& winning_nums = card.first;
-    const IntVec& your_nums = card.second;
-    const int matches = std::accumulate(cbegin(winning_nums), cend(winning_nums), 0, [&](int acc, const auto w_num){
-        return acc + std::any_of(cbegin(your_nums), cend(your_nums), [&](int y_num){ return y_num == w_num; });
-    });
+int calc_card_matches(const PackedCards& cards, size_t i) {
+    /// NB: a number listed twice on one side counts once
+    const Word* winning_nums = cards.winning(i);
+    const Word* your_nums = cards.yours(i);
+    int matches = 0;
+    for (size_t w = 0; w < cards.words_per_set; ++w) {
+        matches += std::popcount(winning_nums[w] & your_nums[w]);
+    }
     return matches;
 }
 
-int calc_total_score(const std::vector<Card>& winning_and_your_numbers) {
-    const auto& wayn = winning_and_your_numbers;
-    return std::accumulate(cbegin(wayn), cend(wayn), 0, [&](int acc, const auto& card){
-        return acc + calc_card_score(calc_card_matches(card));
-    });
+aoc::Answer calc_total_score(const PackedCards& cards) {
+    const aoc::Phase phase {"q4 solve: calc_total_score"};
+    aoc::Answer total = 0;
+    for (size_t i = 0; i < cards.size(); ++i) {
+        total = saturating_add(total, calc_card_score(calc_card_matches(cards, i)));
+    }
+    return total;
 }
 
-std::map<size_t, int> calc_win_map(const std::vector<Card>& cards) {
-    std::map<size_t, int> iw;
+std::pmr::vector<int> calc_matches(const PackedCards& cards) {
+    const aoc::Phase phase {"q4 solve: calc_matches"};
+    std::pmr::vector<int> matches {aoc::scratch()};
+    matches.reserve(cards.size());
     for (size_t i = 0; i < cards.size(); ++i) {
-        iw[i] = calc_card_matches(cards[i]);
+        matches.push_back(calc_card_matches(cards, i));
     }
-    return iw;
+    return matches;
 }
 
-std::vector<int> calc_card_count(const std::vector<int>& initial_count, const std::map<size_t, int>& wins_on_card) {
-    assert(wins_on_card.size() == initial_count.size());
-    std::vector<int> card_count = initial_count;
-    for (size_t i = 0; i < card_count.size(); ++i) {
-        const auto no_of_matches = wins_on_card.at(i);
-        for (size_t m = 1; m <= no_of_matches; ++m) {
-            if (i+m >= card_count.size()) continue;
-            card_count[i+m] += card_count[i];
+using CountVec = std::pmr::vector<aoc::Answer>;
+
+CountVec calc_card_count(const std::pmr::vector<int>& matches) {
+    /// Card i's copies each win a copy of the next matches[i] cards, so rather than adding to each of those cards,
+    /// the copies are added where the run starts and taken away where it ends, and a running sum picks them up
+    /// NB: counts saturate, but the difference array can't, so it's kept in 128 bits: each of the at most
+    /// no_of_cards counts in the running sum is below 2 ^ 63, so it can't overflow
+    const aoc::Phase phase {"q4 solve: calc_card_count"};
+    using Wide = __int128;
+    const size_t no_of_cards = matches.size();
+    CountVec card_count(no_of_cards, 0, aoc::scratch());
+    std::pmr::vector<Wide> won_from_earlier(no_of_cards + 1, 0, aoc::scratch()); // difference array
+    Wide running = 0;
+    for (size_t i = 0; i < no_of_cards; ++i) {
+        running += won_from_earlier[i];
+        card_count[i] = static_cast<aoc::Answer>(std::min<Wide>(1 + running, max_answer));
+        const size_t last_won = std::min(i + static_cast<size_t>(matches[i]), no_of_cards - 1);
+        if (last_won > i) {
+            won_from_earlier[i + 1] += card_count[i];
+            won_from_earlier[last_won + 1] -= card_count[i];
         }
     }
     return card_count;
 }
 
-int main() {
+aoc::Answer solve_part_1(std::string_view input) {
+    const aoc::ScratchScope scratch_scope;
+    const PackedCards cards = parse(input);
+    return calc_total_score(cards);
+}
 
-    std::ifstream data("../data.txt");
-    if (!data.is_open()) {
-        throw std::runtime_error("Unable to open file");
-    }
+aoc::Answer solve_part_2(std::string_view input) {
+    const aoc::ScratchScope scratch_scope;
+    const PackedCards cards = parse(input);
+    const CountVec card_count = calc_card_count(calc_matches(cards));
+    return std::accumulate(cbegin(card_count), cend(card_count), aoc::Answer{0}, saturating_add);
+}
 
-    const std::vector<Card> cards = convert_data(data);
-    const std::map<size_t, int> wins_on_card = calc_win_map(cards);
+}
 
-    const std::vector<int> card_count = [&](){
-        const auto initial_count = std::vector<int>(wins_on_card.size(), 1);
-        return calc_card_count(initial_count, wins_on_card);
-    }();
+#ifndef AOC_NO_MAIN
+int main() {
 
-    const int part_1 = calc_total_score(cards);
-    const int part_2 = std::accumulate(cbegin(card_count), cend(card_count), 0);
+    const aoc::MappedFile data("../data.txt");
 
-    fmt::print("Part 1: {}\n", part_1);
-    fmt::print("Part 2: {}\n", part_2);
+    fmt::print("Part 1: {}\n", q4::solve_part_1(data.view()));
+    fmt::print("Part 2: {}\n", q4::solve_part_2(data.view()));
 
 }
+#endif
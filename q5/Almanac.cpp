@@ -1,8 +1,15 @@
 #include "Almanac.h"
+#include "../common/Input.h"
+#include "../common/Instrument.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace q5 {
 
 std::vector<unsigned long> Almanac::calc_seeds_old() const {
     std::vector<unsigned long> seeds_long_vec;
-    std::transform(cbegin(tokenized_data[0]) + 1, cend(tokenized_data[0]), back_inserter(seeds_long_vec), [](const std::string& str) {
+    std::transform(cbegin(tokenized_data[0]) + 1, cend(tokenized_data[0]), back_inserter(seeds_long_vec), [](std::string_view str) {
         return str_to_num<unsigned long>(str);
     });
     return seeds_long_vec;
@@ -18,8 +25,8 @@ std::vector<Interval> Almanac::calc_seeds_new() const {
     return new_seeds;
 }
 
-std::vector<Source_Destination_Range> Almanac::get_x_almanac_map(const std::string &first_token_of_title) const {
-    std::vector<Source_Destination_Range> map;
+AlmanacMap Almanac::get_x_almanac_map(std::string_view first_token_of_title) const {
+    std::vector<Source_Destination_Range> ranges;
     const auto start = std::ranges::find_if(tokenized_data, [&](const auto& sub_vec){
         return sub_vec.front() == first_token_of_title;
     }) + 1;
@@ -34,26 +41,27 @@ std::vector<Source_Destination_Range> Almanac::get_x_almanac_map(const std::stri
             .range = {source, source + r - 1},
             .jump_distance = destination - source
         };
-        map.push_back(sdr);
+        ranges.push_back(sdr);
+    }
+    std::ranges::sort(ranges, {}, [](const Source_Destination_Range& sdr){ return sdr.range.lower(); });
+
+    AlmanacMap map;
+    map.starts.reserve(ranges.size());
+    map.ends.reserve(ranges.size());
+    map.offsets.reserve(ranges.size());
+    for (const auto& [range, jump_distance] : ranges) {
+        map.starts.push_back(range.lower());
+        map.ends.push_back(range.upper());
+        map.offsets.push_back(jump_distance);
     }
-    std::ranges::sort(new_seeds, {}, &Interval::lower);
     return map;
 }
 
 
-unsigned long Almanac::loc_to_loc(unsigned long thing, const AlmanacMap &map) {
-    for (const auto& entry : map) {
-        if (boost::numeric::in(thing, entry.range)) {
-            return thing + entry.jump_distance;
-        }
-    }
-    return thing;
-}
-
-Almanac::Almanac(std::istream &data)
-        : tokenized_data{tokenize(raw_vector<std::string>(data))}
+Almanac::Almanac(std::string_view data)
+        : tokenized_data{tokenize(aoc::lines(data, aoc::scratch()))}
         , seeds_old{calc_seeds_old()}
-        , seeds_new{calc_seeds_new()}
+        , seeds_new(calc_seeds_new()) // NB: braces would pick the initializer_list constructor
         , maps({get_x_almanac_map("seed-to-soil")
                 , get_x_almanac_map("soil-to-fertilizer")
                 , get_x_almanac_map("fertilizer-to-water")
@@ -61,116 +69,36 @@ Almanac::Almanac(std::istream &data)
                 , get_x_almanac_map("light-to-temperature")
                 , get_x_almanac_map("temperature-to-humidity")
                 , get_x_almanac_map("humidity-to-location")})
+        , seed_to_location_fn{calc_seed_to_location_fn()}
 { }
 
-unsigned long Almanac::seed_to_location(unsigned long seed) const {
+PiecewiseLinear Almanac::calc_seed_to_location_fn() const {
+    PiecewiseLinear fn = PiecewiseLinear::identity();
     for (const auto& map : maps) {
-        seed = loc_to_loc(seed, map);
+        fn = fn.then(PiecewiseLinear::from_map(map));
     }
-    return seed;
+    return fn;
 }
 
-std::vector<Interval> Almanac::split_seed_ranges_based_on_map(const std::vector<Interval> &seed_ranges,
-                                                              const Almanac::AlmanacMap &almanac_map) {
-    /// Split the seed Intervals so that each interval satisfies either of the following properties:
-    /// 1. All seed numbers within the interval map to distinct values on the almanac_map, or
-    /// 2. None of the seed numbers within the interval map to distinct values on the almanac_map
-
-    std::vector<Interval> seeds_that_map = calc_seeds_that_map(seed_ranges, almanac_map);
-
-    std::vector<Interval> seeds_that_dont_map = [&](){
-        const Interval seed_span = {seed_ranges.front().lower(), seed_ranges.back().upper()};
-        const std::vector<Interval> map_intervals = AlmanacMap_to_IntervalVector(almanac_map);
-        try {
-            const std::vector<Interval> map_complement = complement_intervals(seed_span, map_intervals);
-            return calc_seeds_that_map(seed_ranges, map_complement);
-        }
-        catch (std::runtime_error& empty_interval_created) {
-            return std::vector<Interval>{};
-        }
-    }();
-
-    const std::vector<Interval> seeds = [&](){
-        auto s = std::move(seeds_that_map);
-        s.insert(
-            end(seeds),
-            std::make_move_iterator(begin(seeds_that_dont_map)),
-            std::make_move_iterator(end(seeds_that_dont_map))
-        );
-        std::ranges::sort(new_seeds, {}, &Interval::lower);
-        return s;
-    }();
-
-    return seeds;
-
-}
-
-std::vector<Interval>
-Almanac::calc_seeds_that_map(const std::vector<Interval>& seed_ranges, const Almanac::AlmanacMap& almanac_map) {
-    return calc_seeds_that_map(seed_ranges, AlmanacMap_to_IntervalVector(almanac_map));
-}
-
-std::vector<Interval>
-Almanac::calc_seeds_that_map(const std::vector<Interval>& seed_ranges, const std::vector<Interval>& map_vec) {
-    std::vector<Interval> stm;
-    for (const auto& s_range : seed_ranges) {
-        for (const auto& m_range : map_vec) {
-            try {
-                const Interval itv = boost::numeric::intersect(m_range, s_range);
-                stm.push_back(itv);
-            }
-            catch (...) { } // if `itv` is empty interval it throws
-        }
-    }
-    return stm;
+unsigned long Almanac::seed_to_location(unsigned long seed) const {
+    return seed_to_location_fn(seed);
 }
 
-std::vector<Interval> Almanac::AlmanacMap_to_IntervalVector(const Almanac::AlmanacMap& almanac_map) {
-    std::vector<Interval> map_intervals;
-    for (const auto& info : almanac_map) {
-        map_intervals.push_back(info.range);
-    }
-    return map_intervals;
+std::vector<unsigned long> Almanac::final_p1_seeds_locations() const {
+    const aoc::Phase phase {"q5 solve: final_p1_seeds_locations"};
+    auto seeds = seeds_old;
+    std::ranges::transform(seeds, begin(seeds), [&](auto &s) { return seed_to_location(s); });
+    return seeds;
 }
 
-std::vector<Interval> Almanac::seed_range_vector_to_location() const {
-    std::vector<Interval> ranges = seeds_new;
-    for (const auto& map : maps) {
-        std::ranges::sort(new_seeds, {}, &Interval::lower);
-        ranges = split_seed_ranges_based_on_map(ranges, map);
-        ranges = pass_ranges_through_map(ranges, map);
+unsigned long Almanac::lowest_p2_seed_location() const {
+    /// One sweep of the composed function's pieces per seed range
+    const aoc::Phase phase {"q5 solve: lowest_p2_seed_location"};
+    unsigned long lowest = std::numeric_limits<unsigned long>::max();
+    for (const auto& seed_range : seeds_new) {
+        lowest = std::min(lowest, seed_to_location_fn.min_over(seed_range));
     }
-    return ranges;
+    return lowest;
 }
 
-std::vector<Interval>
-Almanac::pass_ranges_through_map(const std::vector<Interval>& ranges, const Almanac::AlmanacMap& almanac_map) {
-
-    std::vector<Interval> new_ranges;
-
-    for (const auto& range : ranges){
-
-        auto map_match = std::ranges::find_if(almanac_map, [&](const Source_Destination_Range &sdr) {
-            return boost::numeric::in(range.lower(), sdr.range); // NB: any num in `range` should work
-        });
-
-        if (map_match == cend(almanac_map)) {
-            new_ranges.push_back(range);
-        }
-        else {
-            const long& jump_distance = map_match->jump_distance;
-            const Interval result = (jump_distance >= 0)
-                    ? static_cast<unsigned long>(jump_distance) + range
-                    : range - static_cast<unsigned long>(-jump_distance);
-            new_ranges.push_back(result);
-        }
-    }
-
-    return new_ranges;
 }
-
-std::vector<unsigned long> Almanac::final_p1_seeds_locations() const {
-    auto seeds = seeds_old;
-    std::ranges::transform(seeds, begin(seeds), [&](auto &s) { return seed_to_location(s); });
-    return seeds;
-}
\ No newline at end of file
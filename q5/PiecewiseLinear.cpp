@@ -0,0 +1,98 @@
+#include "PiecewiseLinear.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace q5 {
+
+namespace {
+
+constexpr unsigned long top = std::numeric_limits<unsigned long>::max();
+
+unsigned long shift(unsigned long x, long offset) {
+    /// x + offset, held at the top of the range rather than wrapping past it
+    if (offset > 0 && x > top - static_cast<unsigned long>(offset)) return top;
+    return x + static_cast<unsigned long>(offset); // NB: wraps back down for a negative offset, as intended
+}
+
+}
+
+void PiecewiseLinear::push_piece(unsigned long start, long offset) {
+    if (!m_offsets.empty() && m_offsets.back() == offset) return;
+    m_starts.push_back(start);
+    m_offsets.push_back(offset);
+}
+
+std::size_t PiecewiseLinear::piece_of(unsigned long x) const {
+    /// The last piece starting at or before x. Branchless: the search takes the same steps whatever x is, and each
+    /// step is a conditional move rather than a branch to mispredict
+    const unsigned long* base = m_starts.data(); // NB: starts[0] is 0, so always <= x
+    for (std::size_t n = m_starts.size(); n > 1; ) {
+        const std::size_t half = n / 2;
+        __builtin_prefetch(base + half / 2); // NB: both places the next step could look, so the miss overlaps this one
+        __builtin_prefetch(base + half + half / 2);
+        base = (base[half] <= x) ? base + half : base;
+        n -= half;
+    }
+    return static_cast<std::size_t>(base - m_starts.data());
+}
+
+unsigned long PiecewiseLinear::piece_end(std::size_t i) const {
+    return (i + 1 < m_starts.size()) ? m_starts[i + 1] - 1 : top;
+}
+
+PiecewiseLinear PiecewiseLinear::identity() {
+    PiecewiseLinear f;
+    f.push_piece(0, 0);
+    return f;
+}
+
+PiecewiseLinear PiecewiseLinear::from_map(const AlmanacMap& map) {
+    /// Each of the map's ranges jumps by its offset and everything else maps to itself. Where ranges overlap the one
+    /// starting lower wins, as it would scanning them in order
+    PiecewiseLinear f;
+    unsigned long current = 0; // first x not yet in a piece
+    for (std::size_t i = 0; i < map.starts.size(); ++i) {
+        const unsigned long first = std::max(map.starts[i], current);
+        if (first > map.ends[i]) continue;
+        if (first > current) f.push_piece(current, 0);
+        f.push_piece(first, map.offsets[i]);
+        if (map.ends[i] == top) return f;
+        current = map.ends[i] + 1;
+    }
+    f.push_piece(current, 0);
+    return f;
+}
+
+PiecewiseLinear PiecewiseLinear::then(const PiecewiseLinear& next) const {
+    /// next(f(x)): each of f's pieces is split wherever its image crosses one of next's breakpoints
+    PiecewiseLinear composed;
+    for (std::size_t i = 0; i < m_starts.size(); ++i) {
+        const long offset = m_offsets[i];
+        const unsigned long image_first = shift(m_starts[i], offset);
+        const unsigned long image_last = shift(piece_end(i), offset);
+
+        std::size_t j = next.piece_of(image_first);
+        composed.push_piece(m_starts[i], offset + next.m_offsets[j]);
+        for (++j; j < next.m_starts.size() && next.m_starts[j] <= image_last; ++j) {
+            composed.push_piece(next.m_starts[j] - static_cast<unsigned long>(offset), offset + next.m_offsets[j]);
+        }
+    }
+    return composed;
+}
+
+unsigned long PiecewiseLinear::operator()(unsigned long x) const {
+    return shift(x, m_offsets[piece_of(x)]);
+}
+
+unsigned long PiecewiseLinear::min_over(const Interval& xs) const {
+    /// f rises within each piece, so only the start of xs and the starts of the pieces inside it can be the lowest
+    std::size_t i = piece_of(xs.lower());
+    unsigned long lowest = shift(xs.lower(), m_offsets[i]);
+    for (++i; i < m_starts.size() && m_starts[i] <= xs.upper(); ++i) {
+        lowest = std::min(lowest, shift(m_starts[i], m_offsets[i]));
+    }
+    return lowest;
+}
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "utils.h"
+
+namespace q5 {
+
+class PiecewiseLinear {
+    /// f(x) = x + offsets[i] for starts[i] <= x < starts[i + 1]. starts[0] is 0 and the last piece runs to the top of
+    /// the range, so f is defined everywhere; neighbouring pieces never share an offset
+    std::vector<unsigned long> m_starts;
+    std::vector<long> m_offsets;
+
+    void push_piece(unsigned long start, long offset);
+    [[nodiscard]] std::size_t piece_of(unsigned long x) const;
+    [[nodiscard]] unsigned long piece_end(std::size_t i) const;
+
+public:
+    PiecewiseLinear() = default; // NB: no pieces, ie. not a function yet, so only for building into
+    [[nodiscard]] static PiecewiseLinear identity();
+    [[nodiscard]] static PiecewiseLinear from_map(const AlmanacMap& map);
+
+    [[nodiscard]] PiecewiseLinear then(const PiecewiseLinear& next) const;
+
+    [[nodiscard]] unsigned long operator()(unsigned long x) const;
+    [[nodiscard]] unsigned long min_over(const Interval& xs) const;
+    [[nodiscard]] std::size_t size() const { return m_starts.size(); }
+};
+
+}
@@ -1,29 +1,42 @@
+#include <algorithm>
 #include <fmt/format.h>
-#include <fstream>
 #include <map>
 #include "Almanac.h"
+#include "../common/Arena.h"
+#include "../common/Days.h"
+#include "../common/Input.h"
+#include "../common/Instrument.h"
 
-int main() {
+namespace q5 {
+
+Almanac parse(std::string_view input) {
+    const aoc::Phase phase {"q5 parse: Almanac"};
+    return Almanac{input};
+}
+
+aoc::Answer solve_part_1(std::string_view input) {
+    const aoc::ScratchScope scratch_scope;
+    const Almanac almanac = parse(input);
+    const auto locations = almanac.final_p1_seeds_locations();
+    return static_cast<aoc::Answer>(*std::ranges::min_element(locations));
+}
 
-    std::ifstream data("../almanac.txt");
-    if (!data.is_open()) {
-        throw std::runtime_error("Unable to open file");
-    }
+aoc::Answer solve_part_2(std::string_view input) {
+    const aoc::ScratchScope scratch_scope;
+    const Almanac almanac = parse(input);
+    return static_cast<aoc::Answer>(almanac.lowest_p2_seed_location());
+}
 
-    const Almanac almanac {data};
+}
 
-    const unsigned long part_1 = [&](){
-        const auto locations = almanac.final_p1_seeds_locations();
-        return *std::ranges::min_element(locations);
-    }();
+#ifndef AOC_NO_MAIN
+int main() {
 
-    const unsigned long part_2 = [&](){
-        const std::vector<Interval> final_ranges = almanac.seed_range_vector_to_location();
-        return std::ranges::min_element(final_ranges, {}, &Interval::lower)->lower();
-    }();
+    const aoc::MappedFile data("../almanac.txt");
 
-    fmt::print("Part 1: {}\n", part_1);
-    fmt::print("Part 2: {}\n", part_2);
+    fmt::print("Part 1: {}\n", q5::solve_part_1(data.view()));
+    fmt::print("Part 2: {}\n", q5::solve_part_2(data.view()));
 
     return 0;
 }
+#endif
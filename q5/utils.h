@@ -1,29 +1,36 @@
 #pragma once
 
-#include <boost/algorithm/string/classification.hpp> // for boost::is_any_of
-#include <boost/algorithm/string/split.hpp> // for boost::split
 #include <boost/numeric/interval.hpp>
 #include <charconv>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/Arena.h"
+#include "../common/Input.h"
+
+namespace q5 {
 
 using Interval = boost::numeric::interval<unsigned long>;
 
-template<typename T>
-[[nodiscard]] std::vector<T> raw_vector(std::istream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
-    }
-    return vec;
-}
+struct Source_Destination_Range {
+    Interval range;
+    long jump_distance;
+};
 
-template<typename T>
-[[nodiscard]] std::vector<T> tokenize(const T& lines_of_data) {
-    std::vector<T> tokenized_lines_of_data;
+struct AlmanacMap {
+    /// One map's ranges as parallel arrays, sorted by start: [starts[i], ends[i]] jumps by offsets[i]
+    std::vector<unsigned long> starts;
+    std::vector<unsigned long> ends;
+    std::vector<long> offsets;
+};
+
+[[nodiscard]] inline std::pmr::vector<std::pmr::vector<std::string_view>> tokenize(const std::pmr::vector<std::string_view>& lines_of_data) {
+    std::pmr::vector<std::pmr::vector<std::string_view>> tokenized_lines_of_data {aoc::scratch()};
+    tokenized_lines_of_data.reserve(lines_of_data.size());
     for (const auto& line : lines_of_data) {
-        T tokens;
-        boost::split(tokens, line, boost::is_any_of(" "), boost::token_compress_on);
-        tokenized_lines_of_data.push_back(tokens);
+        tokenized_lines_of_data.push_back(aoc::split(line, ' ', aoc::scratch()));
     }
     return tokenized_lines_of_data;
 }
@@ -35,4 +42,4 @@ template<typename T>
     return number;
 }
 
-std::vector<Interval> complement_intervals(const Interval& largeInterval, std::vector<Interval> smallIntervals);
\ No newline at end of file
+}
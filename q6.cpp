@@ -1,99 +1,173 @@
-#include <boost/algorithm/string/classification.hpp> // for boost::is_any_of
-#include <boost/algorithm/string/split.hpp> // for boost::split
-#include <fstream>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
 #include <fmt/format.h>
 #include <iostream>
+#include <memory_resource>
 #include <numeric>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
-using Time = int;
-using Distance = int;
+#include "common/Arena.h"
+#include "common/Days.h"
+#include "common/Input.h"
+#include "common/Instrument.h"
+#include "common/ThreadPool.h"
 
-template<typename T>
-[[nodiscard]] std::vector<T> vectorize(std::istream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
-    }
-    return vec;
-}
+namespace q6 {
 
-template<typename T>
-[[nodiscard]] std::vector<T> tokenize(const T& lines_of_data) {
-    std::vector<T> tokenized_lines_of_data;
+using Time = std::int64_t;
+using Distance = std::int64_t;
+
+[[nodiscard]] std::pmr::vector<std::pmr::vector<std::string_view>> tokenize(const std::pmr::vector<std::string_view>& lines_of_data) {
+    std::pmr::vector<std::pmr::vector<std::string_view>> tokenized_lines_of_data {aoc::scratch()};
     for (const auto& line : lines_of_data) {
-        T tokens;
-        boost::split(tokens, line, boost::is_any_of(" "), boost::token_compress_on);
-        tokenized_lines_of_data.push_back(tokens);
+        tokenized_lines_of_data.push_back(aoc::split(line, ' ', aoc::scratch()));
     }
     return tokenized_lines_of_data;
 }
 
-std::vector<std::pair<Time, Distance>> parse(std::ifstream& data) {
+std::int64_t to_int(std::string_view token) {
+    std::int64_t n = 0;
+    std::from_chars(token.data(), token.data() + token.size(), n);
+    return n;
+}
+
+std::pmr::vector<std::pair<Time, Distance>> parse(std::string_view data) {
     /// NB: Guaranteed that input data correctly formatted
-    auto parsed = tokenize(vectorize<std::string>(data));
+    const aoc::Phase phase {"q6 parse"};
+    auto parsed = tokenize(aoc::lines(data, aoc::scratch()));
 
-    std::vector<std::pair<Time, Distance>> result;
+    std::pmr::vector<std::pair<Time, Distance>> result {aoc::scratch()};
 
     for (size_t i = 1; i < parsed[0].size(); ++i) {
-        int time = std::stoi(parsed[0][i]);
-        int distance = std::stoi(parsed[1][i]);
+        Time time = to_int(parsed[0][i]);
+        Distance distance = to_int(parsed[1][i]);
         result.emplace_back(time, distance);
     }
 
     return result;
 }
 
-std::pair<long, long> calc_poss_times(long race_time, long total_distance) {
-    const long a = 1, b = -race_time, c = total_distance;
-    const double sqrt_determinant = std::sqrt((b * b) - (4 * a * c));
-    double bigger = (static_cast<double>(-b) + sqrt_determinant) / (2 * a);
-    double littler = (static_cast<double>(-b) - sqrt_determinant) / (2 * a);
-    if (littler > bigger){
-        std::swap(littler, bigger);
-    }
-    return {littler, bigger};
-    // distance = (race_time - button_press_time) * button_press_time;
-    // => button_press_time^2 - (race_time * button_press_time) + total_distance == 0
+std::int64_t number_of_ways_to_beat_record(Time race_time, Distance record) {
+    /// Holding the button for t ms travels t * (race_time - t), so the winning t lie strictly between the roots of
+    /// t^2 - race_time * t + record. The floating point root only seeds the search; the bound is settled in integers.
+    const auto beats_record = [&](Time t){ return t * (race_time - t) > record; };
+    const double determinant = static_cast<double>(race_time) * static_cast<double>(race_time) - 4.0 * static_cast<double>(record);
+    if (determinant < 0) return 0;
+
+    const Time halfway = race_time / 2; // t * (race_time - t) peaks here, and is symmetric about it
+    Time low = std::clamp(static_cast<Time>((static_cast<double>(race_time) - std::sqrt(determinant)) / 2), Time{0}, halfway);
+    while (low > 0 && beats_record(low - 1)) --low;
+    while (low <= halfway && !beats_record(low)) ++low;
+    if (low > halfway) return 0;
+
+    const Time high = race_time - low;
+    return high - low + 1;
 }
 
-int number_of_ways_to_beat_record(const std::pair<double, double>& range) {
-    const auto low = (std::ceil(range.first) == range.first) ? std::ceil(range.first + 1) : std::ceil(range.first);
-    const auto high = (std::floor(range.second) == range.second) ? std::floor(range.second - 1) : std::floor(range.second);
-    const auto total_ways = (high - low) + 1;
-    return static_cast<int>(total_ways);
-}
-
-std::pair<long, long> part_2_kerning_adjustment(const std::vector<std::pair<Time, Distance>>& time_dist_pairs) {
+std::pair<Time, Distance> part_2_kerning_adjustment(const std::pmr::vector<std::pair<Time, Distance>>& time_dist_pairs) {
     std::string time{};
     std::string distance{};
     for (const auto& p : time_dist_pairs) {
-        time += std::to_string(static_cast<int>(p.first));
-        distance += std::to_string(static_cast<int>(p.second));
+        time += std::to_string(p.first);
+        distance += std::to_string(p.second);
     }
-    return {std::stol(time), std::stol(distance)};
+    return {std::stoll(time), std::stoll(distance)};
 }
 
-int main() {
+aoc::Answer solve_part_1(std::string_view input) {
+    const aoc::ScratchScope scratch_scope;
+    const std::pmr::vector<std::pair<Time, Distance>> time_dist_pairs = parse(input);
+    const aoc::Phase phase {"q6 solve: number_of_ways_to_beat_record"};
+    return std::accumulate(cbegin(time_dist_pairs), cend(time_dist_pairs), aoc::Answer{1}, [](aoc::Answer acc, const auto& pair) {
+        return acc * number_of_ways_to_beat_record(pair.first, pair.second);
+    });
+}
+
+aoc::Answer solve_part_2(std::string_view input) {
+    const aoc::ScratchScope scratch_scope;
+    const std::pmr::vector<std::pair<Time, Distance>> time_dist_pairs = parse(input);
+    const aoc::Phase phase {"q6 solve: number_of_ways_to_beat_record"};
+    const auto pair = part_2_kerning_adjustment(time_dist_pairs);
+    return number_of_ways_to_beat_record(pair.first, pair.second);
+}
 
-    std::ifstream data("../times.txt");
-    if (!data.is_open()) {
-        throw std::runtime_error("Unable to open file");
+// batch mode: every input's races in one structure of arrays, so the kernels run over flat buffers
+
+struct RaceBatch {
+    std::vector<Time> times;
+    std::vector<Distance> records;
+    std::vector<std::size_t> first_race; // input i's races are [first_race[i], first_race[i + 1])
+};
+
+void append_numbers(std::string_view line, bool is_kerned, std::vector<std::int64_t>& numbers) {
+    /// The numbers after the line's label; kerned, the digits all run together into one number
+    line.remove_prefix(line.find(':') + 1);
+    std::int64_t number = 0;
+    bool is_in_number = false;
+    for (const char c : line) {
+        if (c >= '0' && c <= '9') {
+            number = number * 10 + (c - '0');
+            is_in_number = true;
+        }
+        else if (is_in_number && !is_kerned) {
+            numbers.push_back(std::exchange(number, 0));
+            is_in_number = false;
+        }
     }
+    if (is_in_number) numbers.push_back(number);
+}
 
-    const std::vector<std::pair<Time, Distance>> time_dist_pairs = parse(data);
+RaceBatch parse_batch(std::span<const std::string_view> inputs, bool is_kerned) {
+    RaceBatch batch;
+    batch.first_race.reserve(inputs.size() + 1);
+    batch.first_race.push_back(0);
+    for (std::string_view input : inputs) {
+        append_numbers(aoc::next_line(input), is_kerned, batch.times);
+        append_numbers(aoc::next_line(input), is_kerned, batch.records);
+        batch.first_race.push_back(batch.times.size());
+    }
+    return batch;
+}
 
-    const int part_1 = std::reduce(cbegin(time_dist_pairs), cend(time_dist_pairs), 1, [](int acc, const auto& pair) {
-        return acc * number_of_ways_to_beat_record(calc_poss_times(pair.first, pair.second));
+std::vector<aoc::Answer> solve_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool, bool is_kerned) {
+    const RaceBatch batch = parse_batch(inputs, is_kerned);
+    std::vector<aoc::Answer> answers(inputs.size());
+    aoc::parallel_for(pool, inputs.size(), [&](std::size_t begin, std::size_t end){
+        for (std::size_t i = begin; i < end; ++i) {
+            aoc::Answer product = 1;
+            for (std::size_t r = batch.first_race[i]; r < batch.first_race[i + 1]; ++r) {
+                product *= number_of_ways_to_beat_record(batch.times[r], batch.records[r]);
+            }
+            answers[i] = product;
+        }
     });
+    return answers;
+}
+
+std::vector<aoc::Answer> solve_part_1_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool) {
+    return solve_batch(inputs, pool, false);
+}
+
+std::vector<aoc::Answer> solve_part_2_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool) {
+    return solve_batch(inputs, pool, true);
+}
+
+}
+
+#ifndef AOC_NO_MAIN
+int main() {
 
-    const int part_2 = [&](){
-        const auto pair = part_2_kerning_adjustment(time_dist_pairs);
-        return number_of_ways_to_beat_record(calc_poss_times(pair.first, pair.second));
-    }();
+    const aoc::MappedFile data("../times.txt");
 
-    fmt::print("Part 1: {}\n", part_1);
-    fmt::print("Part 2: {}\n", part_2);
+    fmt::print("Part 1: {}\n", q6::solve_part_1(data.view()));
+    fmt::print("Part 2: {}\n", q6::solve_part_2(data.view()));
 
     return 0;
 }
+#endif
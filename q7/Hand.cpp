@@ -1,5 +1,9 @@
 #include "Hand.h"
 
+#include <algorithm>
+
+namespace q7 {
+
 std::array<CardCount, 13> Hand::calc_card_count() const {
     auto no_of_card_value = [&](char c) -> unsigned {
         return std::ranges::count_if(hand, [&](const char& hand_c){ return c == hand_c; });
@@ -95,3 +99,5 @@ bool Part::compare(const Hand &a, const Hand &b) const {
 }
 
 bool operator<(const CardCount &a, const CardCount &b) { return a.count < b.count; }
+
+}
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <array>
 #include <iostream>
+#include <string>
+#include <string_view>
+
+namespace q7 {
 
 struct CardCount {
     unsigned count;
@@ -53,3 +58,4 @@ public:
     Hand::Kind best_move(std::array<CardCount, 13> card_count) const override;
 };
 
+}
@@ -1,38 +1,40 @@
 #pragma once
 
-#include <boost/algorithm/string/classification.hpp> // for boost::is_any_of
-#include <boost/algorithm/string/split.hpp> // for boost::split
-
-template<typename T>
-[[nodiscard]] std::vector<T> vectorize(std::ifstream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
-    }
-    return vec;
-}
+#include <charconv>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/Arena.h"
+#include "../common/Input.h"
 
-template<typename T>
-[[nodiscard]] std::vector<T> tokenize(const T& lines_of_data) {
-    std::vector<T> tokenized_lines_of_data;
+namespace q7 {
+
+[[nodiscard]] inline std::pmr::vector<std::pmr::vector<std::string_view>> tokenize(const std::pmr::vector<std::string_view>& lines_of_data) {
+    std::pmr::vector<std::pmr::vector<std::string_view>> tokenized_lines_of_data {aoc::scratch()};
+    tokenized_lines_of_data.reserve(lines_of_data.size());
     for (const auto& line : lines_of_data) {
-        T tokens;
-        boost::split(tokens, line, boost::is_any_of(" "), boost::token_compress_on);
-        tokenized_lines_of_data.push_back(tokens);
+        if (line.empty()) continue;
+        tokenized_lines_of_data.push_back(aoc::split(line, ' ', aoc::scratch()));
     }
     return tokenized_lines_of_data;
 }
 
-[[nodiscard]] std::vector<Hand_And_Bid> parse(std::ifstream& data, const Part* part) {
+[[nodiscard]] inline std::pmr::vector<Hand_And_Bid> parse(std::string_view data, const Part* part) {
     /// NB: Guaranteed that input data correctly formatted
-    auto parsed = tokenize(vectorize<std::string>(data));
+    auto parsed = tokenize(aoc::lines(data, aoc::scratch()));
 
-    std::vector<Hand_And_Bid> result;
+    std::pmr::vector<Hand_And_Bid> result {aoc::scratch()};
+    result.reserve(parsed.size());
 
     for (auto& row : parsed) {
-        result.emplace_back(Hand_And_Bid{Hand{row[0], part} , std::stoi(row[1])});
+        int bid = 0;
+        std::from_chars(row[1].data(), row[1].data() + row[1].size(), bid);
+        result.emplace_back(Hand_And_Bid{Hand{row[0], part} , bid});
     }
 
     return result;
 }
+
+}
@@ -1,18 +1,29 @@
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
 #include <fmt/format.h>
-#include <fstream>
 #include <iostream>
+#include <span>
+#include <utility>
 #include "Hand.h"
 #include "Utils.h"
+#include "../common/Arena.h"
+#include "../common/Days.h"
+#include "../common/Input.h"
+#include "../common/Instrument.h"
+#include "../common/ThreadPool.h"
 
-[[nodiscard]] unsigned long calc_result(Part&& part, std::string_view str) {
+namespace q7 {
 
-    std::ifstream data(str);
-    if (!data.is_open()) {
-        throw std::runtime_error("Unable to open file");
-    }
+[[nodiscard]] unsigned long calc_result(Part&& part, std::string_view data) {
+    const aoc::ScratchScope scratch_scope;
 
     const auto hands_and_bids = [&](){
-        auto hands_and_bids = parse(data, &part);
+        auto hands_and_bids = [&](){
+            const aoc::Phase phase {"q7 parse"};
+            return parse(data, &part);
+        }();
+        const aoc::Phase phase {"q7 solve: sort"};
         std::ranges::sort(hands_and_bids, [&](const Hand_And_Bid& a, const Hand_And_Bid& b) {
             return part.compare(a.hand, b.hand);
         });
@@ -20,6 +31,7 @@
     }();
 
     const unsigned long result = [&](){
+        const aoc::Phase phase {"q7 solve: total winnings"};
         unsigned long result = 0;
         for (size_t i = 0; i < hands_and_bids.size(); ++i) {
             const auto ranking = i + 1;
@@ -31,13 +43,93 @@
     return result;
 }
 
+aoc::Answer solve_part_1(std::string_view input) {
+    return static_cast<aoc::Answer>(calc_result(P1(), input));
+}
+
+aoc::Answer solve_part_2(std::string_view input) {
+    return static_cast<aoc::Answer>(calc_result(P2(), input));
+}
+
+// batch mode: each hand packed into one sortable integer, every input's hands in one flat buffer
+
+[[nodiscard]] std::uint32_t strength(std::string_view hand, std::string_view order, bool is_joker_wild) {
+    /// Kind in the top bits, then each card's place in `order`, so comparing strengths compares hands like Part::compare
+    std::array<unsigned, 13> count {};
+    for (const char c : hand) {
+        ++count[order.find(c)];
+    }
+    const unsigned jokers = is_joker_wild ? std::exchange(count[order.find('J')], 0) : 0;
+    std::ranges::partial_sort(count, begin(count) + 2, std::ranges::greater{});
+    const Hand::Kind kind = Hand::calc_kind({.count = count[0] + jokers, .type = 0}, {.count = count[1], .type = 0});
+
+    std::uint32_t s = static_cast<std::uint32_t>(kind);
+    for (const char c : hand) {
+        s = (s << 4) | static_cast<std::uint32_t>(order.find(c));
+    }
+    return s;
+}
+
+struct HandBatch {
+    std::vector<std::uint64_t> hands; // strength << 32 | bid, so sorting orders by strength and carries the bid along
+    std::vector<std::size_t> first_hand; // input i's hands are [first_hand[i], first_hand[i + 1])
+};
+
+[[nodiscard]] HandBatch parse_batch(std::span<const std::string_view> inputs, std::string_view order, bool is_joker_wild) {
+    HandBatch batch;
+    batch.first_hand.reserve(inputs.size() + 1);
+    batch.first_hand.push_back(0);
+    for (std::string_view input : inputs) {
+        while (!input.empty()) {
+            const std::string_view line = aoc::next_line(input);
+            if (line.empty()) continue;
+            const auto space = line.find(' ');
+            std::uint32_t bid = 0;
+            std::from_chars(line.data() + space + 1, line.data() + line.size(), bid);
+            batch.hands.push_back(std::uint64_t{strength(line.substr(0, space), order, is_joker_wild)} << 32 | bid);
+        }
+        batch.first_hand.push_back(batch.hands.size());
+    }
+    return batch;
+}
+
+[[nodiscard]] std::vector<aoc::Answer> solve_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool,
+                                                   std::string_view order, bool is_joker_wild) {
+    HandBatch batch = parse_batch(inputs, order, is_joker_wild);
+    std::vector<aoc::Answer> answers(inputs.size());
+    aoc::parallel_for(pool, inputs.size(), [&](std::size_t begin, std::size_t end){
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto first = batch.hands.begin() + static_cast<long>(batch.first_hand[i]);
+            const auto last = batch.hands.begin() + static_cast<long>(batch.first_hand[i + 1]);
+            std::sort(first, last);
+            aoc::Answer result = 0;
+            for (auto it = first; it != last; ++it) {
+                result += (it - first + 1) * static_cast<aoc::Answer>(*it & 0xffffffff);
+            }
+            answers[i] = result;
+        }
+    });
+    return answers;
+}
+
+std::vector<aoc::Answer> solve_part_1_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool) {
+    return solve_batch(inputs, pool, "23456789TJQKA", false);
+}
+
+std::vector<aoc::Answer> solve_part_2_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool) {
+    return solve_batch(inputs, pool, "J23456789TQKA", true);
+}
+
+}
+
+#ifndef AOC_NO_MAIN
 int main() {
 
-    const unsigned long part_1 = calc_result(P1(), "../hands.txt");
-    const unsigned long part_2 = calc_result(P2(), "../hands.txt");
+    const aoc::MappedFile data("../hands.txt");
 
-    fmt::print("Part 1: {}\n", part_1);
-    fmt::print("Part 2: {}\n", part_2);
+    fmt::print("Part 1: {}\n", q7::solve_part_1(data.view()));
+    fmt::print("Part 2: {}\n", q7::solve_part_2(data.view()));
 
     return 0;
 }
+#endif
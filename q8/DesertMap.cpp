@@ -1,24 +1,29 @@
+#include <algorithm>
 #include <iostream>
 #include <numeric>
 
 #include "DesertMap.h"
+#include "../common/Input.h"
 
-DesertMap::DesertMap(std::istream &data)
-        : vectorize_data{vectorize<std::string>(data)}
-        , move_cycle{vectorize_each_char(vectorize_data[0])}
+namespace q8 {
+
+DesertMap::DesertMap(std::string_view data)
+        : lines_of_data{aoc::lines(data, aoc::scratch())}
+        , move_cycle{vectorize_each_char(lines_of_data[0])}
         , source_to_lr_destinations{extract_map()}
 {
-    vectorize_data.clear();
-    vectorize_data.shrink_to_fit();
+    lines_of_data.clear();
+    lines_of_data.shrink_to_fit();
 }
 
 DesertMap::Source_And_LR_Map DesertMap::extract_map() const {
 
     const auto tokenized = [&](){
-        std::vector<std::vector<std::string>> tokenized = tokenize(vectorize_data);
+        std::pmr::vector<std::pmr::vector<std::string_view>> tokenized = tokenize(lines_of_data);
         for (size_t i = 1; i < tokenized.size(); ++i) { // can skip tokenized[0]
             for (auto &str: tokenized[i]) {
-                boost::range::remove_erase_if(str, boost::is_any_of("(),"));
+                str.remove_prefix(std::min(str.find_first_not_of("(),"), str.size()));
+                str.remove_suffix(str.size() - std::min(str.find_last_not_of("(),") + 1, str.size()));
             }
         }
         return tokenized;
@@ -27,7 +32,7 @@ DesertMap::Source_And_LR_Map DesertMap::extract_map() const {
     const auto mp = [&](){
         Source_And_LR_Map mp;
         for (size_t i = 2; i < tokenized.size(); ++i) {
-            mp[tokenized[i][0]] = {tokenized[i][2], tokenized[i][3]};
+            mp[std::string(tokenized[i][0])] = {std::string(tokenized[i][2]), std::string(tokenized[i][3])};
         }
         return mp;
     }();
@@ -70,3 +75,5 @@ unsigned DesertMap::steps(std::string pos, bool is_ghost) const {
 
     return step;
 }
+
+}
@@ -1,16 +1,19 @@
 #pragma once
 
-#include <boost/range/algorithm.hpp>
-#include <boost/range/algorithm_ext.hpp>
 #include <map>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
 
 #include "Utils.h"
 
+namespace q8 {
+
 using SourceDestDistancesMap = std::map<std::pair<std::string,std::string>, std::optional<unsigned>>;
 
 class DesertMap {
     using Source_And_LR_Map = std::map<std::string, std::pair<std::string, std::string>>;
-    std::vector<std::string> vectorize_data; // USED FOR INITIALIZATION THEN FREED
+    std::pmr::vector<std::string_view> lines_of_data; // USED FOR INITIALIZATION THEN FREED (lives in the solve's scratch arena)
     std::vector<char> move_cycle;
     Source_And_LR_Map source_to_lr_destinations;
     SourceDestDistancesMap all_start_to_all_dest_lengths;
@@ -19,6 +22,7 @@ class DesertMap {
 public:
     [[nodiscard]] unsigned steps(std::string pos, bool ghost) const;
     [[nodiscard]] uint64_t part_2_solution() const;
-    explicit DesertMap(std::istream& data);
+    explicit DesertMap(std::string_view data);
 };
 
+}
@@ -1,9 +1,13 @@
 #include "Utils.h"
 
+namespace q8 {
+
 std::vector<char> vectorize_each_char(std::string_view str) {
     std::vector<char> vec;
     for (const auto c : str) {
         vec.push_back(c);
     }
     return vec;
-}
\ No newline at end of file
+}
+
+}
@@ -1,29 +1,24 @@
 #pragma once
 
-#include <boost/algorithm/string/classification.hpp> // for boost::is_any_of
-#include <boost/algorithm/string/split.hpp> // for boost::split
-#include <fstream>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <vector>
 
-template<typename T>
-std::vector<T> vectorize(std::istream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
-    }
-    return vec;
-}
+#include "../common/Arena.h"
+#include "../common/Input.h"
+
+namespace q8 {
 
-template<typename T>
-[[nodiscard]] std::vector<T> tokenize(const T& lines_of_data) {
-    std::vector<T> tokenized_lines_of_data;
+[[nodiscard]] inline std::pmr::vector<std::pmr::vector<std::string_view>> tokenize(const std::pmr::vector<std::string_view>& lines_of_data) {
+    std::pmr::vector<std::pmr::vector<std::string_view>> tokenized_lines_of_data {aoc::scratch()};
+    tokenized_lines_of_data.reserve(lines_of_data.size());
     for (const auto& line : lines_of_data) {
-        T tokens;
-        boost::split(tokens, line, boost::is_any_of(" "), boost::token_compress_on);
-        tokenized_lines_of_data.push_back(tokens);
+        tokenized_lines_of_data.push_back(aoc::split(line, ' ', aoc::scratch()));
     }
     return tokenized_lines_of_data;
 }
 
 std::vector<char> vectorize_each_char(std::string_view str);
+
+}
@@ -1,22 +1,43 @@
 #include <fmt/format.h>
-#include <fstream>
 #include <iostream>
 #include "DesertMap.h"
+#include "../common/Arena.h"
+#include "../common/Days.h"
+#include "../common/Input.h"
+#include "../common/Instrument.h"
 
-int main() {
+namespace q8 {
+
+aoc::Answer solve_part_1(std::string_view input) {
+    const aoc::ScratchScope scratch_scope;
+    const DesertMap desert_map = [&](){
+        const aoc::Phase phase {"q8 parse: DesertMap"};
+        return DesertMap{input};
+    }();
+    const aoc::Phase phase {"q8 solve: steps"};
+    return desert_map.steps("AAA", false);
+}
 
-    std::ifstream data("../maps.txt");
-    if (!data.is_open()) {
-        throw std::runtime_error("Unable to open file");
-    }
+aoc::Answer solve_part_2(std::string_view input) {
+    const aoc::ScratchScope scratch_scope;
+    const DesertMap desert_map = [&](){
+        const aoc::Phase phase {"q8 parse: DesertMap"};
+        return DesertMap{input};
+    }();
+    const aoc::Phase phase {"q8 solve: part_2_solution"};
+    return static_cast<aoc::Answer>(desert_map.part_2_solution());
+}
 
-    const DesertMap desert_map {data};
+}
+
+#ifndef AOC_NO_MAIN
+int main() {
 
-    const auto part_1 = desert_map.steps("AAA", false);
-    const auto part_2 = desert_map.part_2_solution();
+    const aoc::MappedFile data("../maps.txt");
 
-    fmt::print("Part 1: {}\n", part_1);
-    fmt::print("Part 2: {}\n", part_2);
+    fmt::print("Part 1: {}\n", q8::solve_part_1(data.view()));
+    fmt::print("Part 2: {}\n", q8::solve_part_2(data.view()));
 
     return 0;
 }
+#endif
@@ -1,79 +1,171 @@
-#include <boost/algorithm/string/classification.hpp> // for boost::is_any_of
-#include <boost/algorithm/string/split.hpp> // for boost::split
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
 #include <fmt/format.h>
-#include <fstream>
 #include <iostream>
+#include <memory_resource>
 #include <numeric>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
 
-template<typename T>
-[[nodiscard]] std::vector<T> vectorize(std::ifstream& is) {
-    std::vector<T> vec;
-    T str;
-    while(std::getline(is, str)){
-        vec.push_back(str);
-    }
-    return vec;
-}
+#include "common/Arena.h"
+#include "common/Days.h"
+#include "common/Input.h"
+#include "common/Instrument.h"
+#include "common/ThreadPool.h"
 
-template<typename T>
-[[nodiscard]] std::vector<std::vector<int>> tokenize(const std::vector<T>& lines_of_data) {
-    std::vector<std::vector<int>> tokenized_lines_of_data;
-
-    for (const auto& line : lines_of_data) {
+namespace q9 {
 
-        const std::vector<std::string> tokens = [&](){
-            std::vector<std::string> tokens;
-            boost::split(tokens, line, boost::is_any_of(" "), boost::token_compress_on);
-            return tokens;
-        }();
-
-        const std::vector<int> int_tokens = [&](){
-            std::vector<int> int_tokens;
-            int_tokens.reserve(tokens.size());
-            for (const auto &token: tokens) {
-                int_tokens.push_back(std::stoi(token));
-            }
-            return int_tokens;
-        }();
+[[nodiscard]] std::pmr::vector<std::pmr::vector<std::int64_t>> tokenize(const std::pmr::vector<std::string_view>& lines_of_data) {
+    std::pmr::vector<std::pmr::vector<std::int64_t>> tokenized_lines_of_data {aoc::scratch()};
+    tokenized_lines_of_data.reserve(lines_of_data.size());
 
-        tokenized_lines_of_data.push_back(int_tokens);
+    for (const auto& line : lines_of_data) {
+        /// NB: numbers are read straight off the line, into a vector sized up front, so nothing is left behind in the
+        /// arena but the numbers themselves
+        std::pmr::vector<std::int64_t> int_tokens {aoc::scratch()};
+        int_tokens.reserve(static_cast<std::size_t>(std::ranges::count(line, ' ')) + 1);
+        const char* it = line.data();
+        const char* const end = line.data() + line.size();
+        while (it != end) {
+            std::int64_t n = 0;
+            const auto [next, error] = std::from_chars(it, end, n);
+            if (error != std::errc{}) break;
+            int_tokens.push_back(n);
+            it = next;
+            while (it != end && *it == ' ') ++it;
+        }
+        tokenized_lines_of_data.push_back(std::move(int_tokens));
     }
     return tokenized_lines_of_data;
 }
 
-std::vector<std::vector<int>> parse(std::string_view file_name) {
-    std::ifstream data(file_name);
-    return tokenize(vectorize<std::string>(data));
+std::pmr::vector<std::pmr::vector<std::int64_t>> parse(std::string_view data) {
+    const aoc::Phase phase {"q9 parse"};
+    return tokenize(aoc::lines(data, aoc::scratch()));
 }
 
 enum class End {FRONT, BACK};
 
-[[nodiscard]] int predict_next_num_in_sequence(std::vector<int> vec, End predicting) {
-    if (std::ranges::all_of(vec, [&](const int num){ return vec[0] == num; })) {
-        return vec[0];
-    }
-    else {
-        const auto prev = vec;
-        std::adjacent_difference(begin(vec), end(vec), begin(vec));
-        vec.erase(begin(vec));
-        const auto nth_most = (predicting == End::FRONT) ? prev.front() : prev.back();
-        const int multiplier = (predicting == End::FRONT) ? -1 : 1;
-        return nth_most + multiplier * predict_next_num_in_sequence(vec, predicting);
+[[nodiscard]] std::int64_t extrapolate(std::span<std::int64_t> rows, End predicting) {
+    /// Differences `rows` in place, one row at a time, adding up the edge that each row contributes to the prediction
+    std::int64_t prediction = 0;
+    std::int64_t sign = 1;
+    for (std::size_t size = rows.size(); size > 0; --size) {
+        if (std::all_of(rows.begin(), rows.begin() + static_cast<long>(size), [](std::int64_t n){ return n == 0; })) {
+            break;
+        }
+        if (predicting == End::BACK) {
+            prediction += rows[size - 1];
+        }
+        else {
+            prediction += sign * rows[0];
+            sign = -sign;
+        }
+        for (std::size_t i = 0; i + 1 < size; ++i) {
+            rows[i] = rows[i + 1] - rows[i];
+        }
     }
+    return prediction;
 }
 
-int main() {
-    const auto sequences = parse("../sequences.txt");
+[[nodiscard]] std::int64_t predict_next_num_in_sequence(std::span<const std::int64_t> sequence, End predicting,
+                                                       std::pmr::vector<std::int64_t>& rows) {
+    /// NB: `rows` is only working space, reused from one sequence to the next so the scratch used is one sequence's
+    /// worth rather than a copy of every row of differences of every sequence
+    rows.assign(sequence.begin(), sequence.end());
+    return extrapolate(rows, predicting);
+}
+
+aoc::Answer solve_part_1(std::string_view input) {
+    const aoc::ScratchScope scratch_scope;
+    const auto sequences = parse(input);
+    const aoc::Phase phase {"q9 solve: predict_next_num_in_sequence"};
+    std::pmr::vector<std::int64_t> rows {aoc::scratch()};
+    return std::accumulate(cbegin(sequences), cend(sequences), aoc::Answer{0}, [&rows](aoc::Answer acc, const auto& seq){
+        return acc + predict_next_num_in_sequence(seq, End::BACK, rows);
+    });
+}
 
-    const auto part_1 = std::accumulate(cbegin(sequences), cend(sequences), 0, [](int acc, const auto& seq){
-        return acc + predict_next_num_in_sequence(seq, End::BACK);
+aoc::Answer solve_part_2(std::string_view input) {
+    const aoc::ScratchScope scratch_scope;
+    const auto sequences = parse(input);
+    const aoc::Phase phase {"q9 solve: predict_next_num_in_sequence"};
+    std::pmr::vector<std::int64_t> rows {aoc::scratch()};
+    return std::accumulate(cbegin(sequences), cend(sequences), aoc::Answer{0}, [&rows](aoc::Answer acc, const auto& seq){
+        return acc + predict_next_num_in_sequence(seq, End::FRONT, rows);
     });
-    const auto part_2 = std::accumulate(cbegin(sequences), cend(sequences), 0, [](int acc, const auto& seq){
-        return acc + predict_next_num_in_sequence(seq, End::FRONT);
+}
+
+// batch mode: every sequence of every input in one flat buffer
+
+struct SequenceBatch {
+    std::vector<std::int64_t> values;
+    std::vector<std::size_t> first_value;    // sequence j is values[first_value[j], first_value[j + 1])
+    std::vector<std::size_t> first_sequence; // input i's sequences are [first_sequence[i], first_sequence[i + 1])
+};
+
+[[nodiscard]] SequenceBatch parse_batch(std::span<const std::string_view> inputs) {
+    SequenceBatch batch;
+    batch.first_value.push_back(0);
+    batch.first_sequence.reserve(inputs.size() + 1);
+    batch.first_sequence.push_back(0);
+    for (std::string_view input : inputs) {
+        while (!input.empty()) {
+            const std::string_view line = aoc::next_line(input);
+            const char* it = line.data();
+            const char* const end = line.data() + line.size();
+            while (it != end) {
+                std::int64_t n = 0;
+                const auto [next, error] = std::from_chars(it, end, n);
+                if (error != std::errc{}) break; // NB: stops at anything that isn't a number rather than spinning on it
+                batch.values.push_back(n);
+                it = next;
+                while (it != end && *it == ' ') ++it;
+            }
+            batch.first_value.push_back(batch.values.size());
+        }
+        batch.first_sequence.push_back(batch.first_value.size() - 1);
+    }
+    return batch;
+}
+
+[[nodiscard]] std::vector<aoc::Answer> solve_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool, End predicting) {
+    SequenceBatch batch = parse_batch(inputs);
+    std::vector<aoc::Answer> answers(inputs.size());
+    aoc::parallel_for(pool, inputs.size(), [&](std::size_t begin, std::size_t end){
+        for (std::size_t i = begin; i < end; ++i) {
+            aoc::Answer sum = 0;
+            for (std::size_t j = batch.first_sequence[i]; j < batch.first_sequence[i + 1]; ++j) {
+                const std::span<std::int64_t> sequence {batch.values.data() + batch.first_value[j],
+                                                        batch.first_value[j + 1] - batch.first_value[j]};
+                sum += extrapolate(sequence, predicting); // NB: consumes the sequence, each part parses its own batch
+            }
+            answers[i] = sum;
+        }
     });
+    return answers;
+}
+
+std::vector<aoc::Answer> solve_part_1_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool) {
+    return solve_batch(inputs, pool, End::BACK);
+}
+
+std::vector<aoc::Answer> solve_part_2_batch(std::span<const std::string_view> inputs, aoc::ThreadPool* pool) {
+    return solve_batch(inputs, pool, End::FRONT);
+}
+
+}
+
+#ifndef AOC_NO_MAIN
+int main() {
+    const aoc::MappedFile data("../sequences.txt");
 
-    fmt::print("Part 1: {}\n", part_1);
-    fmt::print("Part 2: {}\n", part_2);
+    fmt::print("Part 1: {}\n", q9::solve_part_1(data.view()));
+    fmt::print("Part 2: {}\n", q9::solve_part_2(data.view()));
 
     return 0;
 }
+#endif
@@ -0,0 +1,219 @@
+// Runs every part of every (day, input) pair in a manifest concurrently and prints the answers in manifest order.
+//
+// Build: every day source with -DAOC_NO_MAIN, plus common/*.cpp and this file.
+// Usage: aoc [--threads <n>] [--phases] [--cache <file>] <manifest>     (use - to read the manifest from stdin)
+//   --phases prints each part's wall time, allocations and peak RSS broken down by the phases it records.
+//   --cache reuses answers for inputs this build has already solved, keyed by a hash of the input's contents.
+//
+// Manifest: one "<day> <input path>" per line; blank lines and lines starting with '#' are skipped. Relative input
+// paths are relative to the manifest's directory.
+
+#include <boost/filesystem.hpp>
+#include <cstdio>
+#include <fmt/format.h>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/Days.h"
+#include "../common/Hash.h"
+#include "../common/Input.h"
+#include "../common/Instrument.h"
+#include "../common/ResultCache.h"
+#include "../common/ThreadPool.h"
+
+namespace {
+
+struct Entry {
+    int day;
+    std::string path;
+};
+
+struct SharedInput {
+    /// Mapped, and hashed if need be, on first use by whichever part gets there first, and unmapped once nothing
+    /// refers to it
+    std::string path;
+    std::once_flag once;
+    std::optional<aoc::MappedFile> file;
+    std::once_flag hash_once;
+    aoc::Hash128 hash_value {};
+
+    explicit SharedInput(std::string path) : path{std::move(path)} { }
+
+    std::string_view view() {
+        std::call_once(once, [&](){ file.emplace(path); });
+        return file->view();
+    }
+
+    aoc::Hash128 hash() {
+        std::call_once(hash_once, [&](){
+            const aoc::Phase phase {"hash"};
+            hash_value = aoc::hash128(view());
+        });
+        return hash_value;
+    }
+};
+
+struct PartResult {
+    aoc::Answer answer;
+    std::vector<aoc::PhaseStats> phases;
+    bool is_cached = false;
+    std::optional<aoc::Hash128> input_hash; // only when there's a cache to look the answer up in, or to save it to
+};
+
+struct Outcome {
+    std::optional<PartResult> result;
+    std::string error;
+};
+
+std::vector<Entry> parse_manifest(std::string_view manifest, const boost::filesystem::path& base_dir) {
+    std::vector<Entry> entries;
+    std::size_t line_no = 0;
+    while (!manifest.empty()) {
+        const std::string_view line = aoc::next_line(manifest);
+        ++line_no;
+        if (line.empty() || line.front() == '#') continue;
+
+        std::istringstream fields {std::string(line)};
+        int day = 0;
+        std::string path;
+        if (!(fields >> day >> path)) {
+            throw std::runtime_error(fmt::format("Manifest line {}: expected <day> <input path>", line_no));
+        }
+        const boost::filesystem::path input_path {path};
+        entries.push_back({day, input_path.is_absolute() ? path : (base_dir / input_path).string()});
+    }
+    return entries;
+}
+
+std::string read_manifest(std::string_view source) {
+    if (source == "-") {
+        return {std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>()};
+    }
+    const aoc::MappedFile file(source);
+    return std::string(file.view());
+}
+
+Outcome collect(std::future<PartResult>& result) {
+    try {
+        return {result.get(), {}};
+    }
+    catch (const std::exception& err) {
+        return {std::nullopt, err.what()};
+    }
+}
+
+void print_phases(const std::vector<aoc::PhaseStats>& phases) {
+    for (const auto& phase : phases) {
+        fmt::print("    {:<45} {:>6} calls {:>12.3f} ms {:>10} allocs {:>14} B alloc {:>10.1f} MB peak RSS\n",
+                   phase.name, phase.calls, static_cast<double>(phase.wall.count()) / 1e6,
+                   phase.allocs.count, phase.allocs.bytes, static_cast<double>(phase.peak_rss_bytes) / 1e6);
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+
+    std::size_t no_of_threads = std::thread::hardware_concurrency();
+    std::string manifest_source;
+    std::string cache_path;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            no_of_threads = std::stoul(argv[++i]);
+        }
+        else if (arg == "--phases") {
+            aoc::enable_instrumentation(true);
+        }
+        else if (arg == "--cache" && i + 1 < argc) {
+            cache_path = argv[++i];
+        }
+        else {
+            manifest_source = arg;
+        }
+    }
+    if (manifest_source.empty()) {
+        fmt::print(stderr, "Usage: aoc [--threads <n>] [--phases] [--cache <file>] <manifest>\n");
+        return 1;
+    }
+
+    const boost::filesystem::path base_dir = (manifest_source == "-")
+            ? boost::filesystem::current_path()
+            : boost::filesystem::path{manifest_source}.parent_path();
+    const std::vector<Entry> entries = parse_manifest(read_manifest(manifest_source), base_dir);
+
+    std::optional<aoc::ResultCache> cache;
+    if (!cache_path.empty()) {
+        cache.emplace(cache_path, aoc::build_key());
+    }
+
+    std::vector<std::future<PartResult>> results;
+    {
+        /// Each input is hashed in the pool, by whichever of its parts runs first, rather than one after another here
+        /// NB: the cache is only read until the pool is done, so the parts can look up answers concurrently
+        const aoc::ResultCache* const cache_to_read = cache.has_value() ? &*cache : nullptr;
+        aoc::ThreadPool pool {no_of_threads};
+        for (const Entry& entry : entries) {
+            auto input = std::make_shared<SharedInput>(entry.path);
+            for (const int part : {1, 2}) {
+                results.push_back(pool.submit([entry, part, input, cache_to_read](){
+                    aoc::reset_thread_phase_stats();
+                    std::optional<aoc::Hash128> input_hash;
+                    if (cache_to_read != nullptr) {
+                        input_hash = input->hash();
+                        if (const auto answer = cache_to_read->find(entry.day, part, *input_hash)) {
+                            return PartResult{*answer, aoc::thread_phase_stats(), true, input_hash};
+                        }
+                    }
+                    const aoc::Day& day = aoc::day(entry.day);
+                    const std::string_view data = input->view();
+                    aoc::Answer answer = 0;
+                    {
+                        const aoc::Phase phase {"solve"};
+                        answer = (part == 1 ? day.part_1 : day.part_2)(data);
+                    }
+                    return PartResult{answer, aoc::thread_phase_stats(), false, input_hash};
+                }));
+            }
+        }
+    }
+
+    bool all_ok = true;
+    {
+        const aoc::Phase phase {"output"};
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Entry& entry = entries[i / 2];
+            const Outcome outcome = collect(results[i]);
+            if (outcome.result.has_value()) {
+                const PartResult& result = *outcome.result;
+                fmt::print("day {:>2} part {} {}: {}\n", entry.day, i % 2 + 1, entry.path, result.answer);
+                if (aoc::instrumentation_enabled() && result.is_cached) {
+                    fmt::print("    (cached)\n");
+                }
+                print_phases(result.phases);
+                if (cache.has_value() && !result.is_cached && result.input_hash.has_value()) {
+                    cache->insert(entry.day, static_cast<int>(i % 2 + 1), *result.input_hash, result.answer);
+                }
+            }
+            else {
+                fmt::print("day {:>2} part {} {}: error: {}\n", entry.day, i % 2 + 1, entry.path, outcome.error);
+                all_ok = false;
+            }
+        }
+    }
+    print_phases(aoc::thread_phase_stats());
+
+    if (cache.has_value()) {
+        cache->save();
+    }
+
+    return all_ok ? 0 : 1;
+}
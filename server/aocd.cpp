@@ -0,0 +1,131 @@
+// Long-lived solver daemon: answers (day, part, input) requests over a Unix domain socket.
+//
+// Build: every day source with -DAOC_NO_MAIN, plus common/*.cpp and this file.
+// Usage: aocd [--socket <path>] [--threads <n>]     (default socket /tmp/aoc.sock; stop with SIGINT or SIGTERM)
+//
+// Each connection gets a thread that reads its requests one at a time; the solving itself happens on a pool
+// started up front, so the number of concurrent solves stays at --threads however many clients connect.
+
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <fmt/format.h>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+#include "../common/Days.h"
+#include "../common/Protocol.h"
+#include "../common/ThreadPool.h"
+
+namespace {
+
+namespace protocol = aoc::protocol;
+
+volatile std::sig_atomic_t g_is_stopping = 0;
+
+void request_stop(int) {
+    g_is_stopping = 1;
+}
+
+class Connections {
+    /// Open connections, so shutdown can wake their threads and wait for them to finish
+    std::mutex m_mutex;
+    std::condition_variable m_all_closed;
+    std::set<int> m_fds;
+
+public:
+    void add(int fd) {
+        const std::lock_guard lock {m_mutex};
+        m_fds.insert(fd);
+    }
+    void remove(int fd) {
+        const std::lock_guard lock {m_mutex};
+        m_fds.erase(fd);
+        if (m_fds.empty()) m_all_closed.notify_all();
+    }
+    void close_all_and_wait() {
+        std::unique_lock lock {m_mutex};
+        for (const int fd : m_fds) {
+            shutdown(fd, SHUT_RDWR); // NB: the owning thread still closes it
+        }
+        m_all_closed.wait(lock, [&](){ return m_fds.empty(); });
+    }
+};
+
+protocol::Response solve(const protocol::Request& request, aoc::ThreadPool& pool) {
+    auto answer = pool.submit([&request](){
+        if (request.part != 1 && request.part != 2) {
+            throw std::invalid_argument("Part must be 1 or 2");
+        }
+        const aoc::Day& day = aoc::day(request.day);
+        return (request.part == 1 ? day.part_1 : day.part_2)(request.input);
+    });
+    try {
+        return {.is_error = false, .answer = answer.get(), .message = {}};
+    }
+    catch (const std::exception& err) {
+        return {.is_error = true, .answer = 0, .message = err.what()};
+    }
+}
+
+void serve(protocol::Socket connection, aoc::ThreadPool& pool, Connections& connections) {
+    protocol::Request request; // NB: reused, so a connection's input buffer only grows to its largest request
+    try {
+        while (protocol::read_request(connection.fd(), request)) {
+            protocol::write_response(connection.fd(), solve(request, pool));
+        }
+    }
+    catch (const std::exception& err) {
+        if (!g_is_stopping) {
+            fmt::print(stderr, "aocd: dropping connection: {}\n", err.what());
+        }
+    }
+    connections.remove(connection.fd());
+}
+
+}
+
+int main(int argc, char** argv) {
+
+    std::string socket_path = "/tmp/aoc.sock";
+    std::size_t no_of_threads = std::thread::hardware_concurrency();
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string_view arg = argv[i];
+        if (arg == "--socket") {
+            socket_path = argv[i + 1];
+        }
+        else if (arg == "--threads") {
+            no_of_threads = std::stoul(argv[i + 1]);
+        }
+    }
+
+    struct sigaction on_stop {};
+    on_stop.sa_handler = request_stop; // NB: no SA_RESTART, so a blocked accept() returns EINTR
+    sigaction(SIGINT, &on_stop, nullptr);
+    sigaction(SIGTERM, &on_stop, nullptr);
+
+    aoc::ThreadPool pool {no_of_threads};
+    Connections connections;
+    const protocol::Socket listener = protocol::listen_unix(socket_path);
+    fmt::print(stderr, "aocd: listening on {} with {} solver threads\n", socket_path, pool.size());
+
+    while (!g_is_stopping) {
+        const int fd = accept4(listener.fd(), nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Unable to accept connection");
+        }
+        connections.add(fd);
+        std::thread(serve, protocol::Socket{fd}, std::ref(pool), std::ref(connections)).detach();
+    }
+
+    connections.close_all_and_wait();
+    unlink(socket_path.c_str());
+    return 0;
+}
@@ -0,0 +1,43 @@
+// Sends one input to a running aocd and prints the answer.
+//
+// Build: common/Protocol.cpp, common/Input.cpp and this file.
+// Usage: aoc-client [--socket <path>] <day> <part> <input path>
+
+#include <fmt/format.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/Input.h"
+#include "../common/Protocol.h"
+
+int main(int argc, char** argv) {
+
+    std::string socket_path = "/tmp/aoc.sock";
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            socket_path = argv[++i];
+        }
+        else {
+            positional.emplace_back(arg);
+        }
+    }
+    if (positional.size() != 3) {
+        fmt::print(stderr, "Usage: aoc-client [--socket <path>] <day> <part> <input path>\n");
+        return 1;
+    }
+
+    const aoc::MappedFile input(positional[2]);
+    const aoc::protocol::Socket connection = aoc::protocol::connect_unix(socket_path);
+    aoc::protocol::write_request(connection.fd(), std::stoi(positional[0]), std::stoi(positional[1]), input.view());
+    const aoc::protocol::Response response = aoc::protocol::read_response(connection.fd());
+
+    if (response.is_error) {
+        fmt::print(stderr, "error: {}\n", response.message);
+        return 1;
+    }
+    fmt::print("{}\n", response.answer);
+    return 0;
+}
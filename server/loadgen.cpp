@@ -0,0 +1,140 @@
+// Drives a running aocd from several connections at once and reports request latency percentiles.
+//
+// Build: common/Protocol.cpp, common/Input.cpp, gen/Generators.cpp and this file.
+// Usage: aoc-loadgen [--socket <path>] [--connections <n>] [--requests <n>] [--seed <n>] <workload>...
+//   where a workload is <day>:<input path>, or <day>@<scale> for a generated input.
+//   Each connection sends its share of --requests back to back, cycling through the workloads and both parts.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fmt/format.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../common/Input.h"
+#include "../common/Protocol.h"
+#include "../gen/Generators.h"
+
+namespace {
+
+struct Workload {
+    int day;
+    std::string input;
+};
+
+struct ConnectionStats {
+    std::vector<std::chrono::nanoseconds> latencies;
+    std::size_t errors = 0;
+};
+
+Workload load_workload(std::string_view arg, std::uint64_t seed) {
+    /// <day>:<input path> or <day>@<scale>
+    const auto separator = arg.find_first_of(":@");
+    if (separator == std::string_view::npos) {
+        throw std::invalid_argument("Expected <day>:<input path> or <day>@<scale>");
+    }
+    const int day = std::stoi(std::string(arg.substr(0, separator)));
+    const std::string rest {arg.substr(separator + 1)};
+    if (arg[separator] == '@') {
+        return {day, aoc::gen::generate(day, static_cast<unsigned>(std::stoul(rest)), seed)};
+    }
+    const aoc::MappedFile file(rest);
+    return {day, std::string(file.view())};
+}
+
+ConnectionStats drive(std::string_view socket_path, const std::vector<Workload>& workloads,
+                      std::size_t first_request, std::size_t no_of_requests) {
+    ConnectionStats stats;
+    stats.latencies.reserve(no_of_requests);
+    const aoc::protocol::Socket connection = aoc::protocol::connect_unix(socket_path);
+    for (std::size_t i = first_request; i < first_request + no_of_requests; ++i) {
+        const Workload& workload = workloads[(i / 2) % workloads.size()];
+        const auto start = std::chrono::steady_clock::now();
+        aoc::protocol::write_request(connection.fd(), workload.day, static_cast<int>(i % 2 + 1), workload.input);
+        const aoc::protocol::Response response = aoc::protocol::read_response(connection.fd());
+        stats.latencies.push_back(std::chrono::steady_clock::now() - start);
+        stats.errors += response.is_error ? 1 : 0;
+    }
+    return stats;
+}
+
+double percentile_us(const std::vector<std::chrono::nanoseconds>& sorted, double p) {
+    const auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+    const std::size_t ix = std::clamp<std::size_t>(rank, 1, sorted.size()) - 1;
+    return static_cast<double>(sorted[ix].count()) / 1e3;
+}
+
+}
+
+int main(int argc, char** argv) {
+
+    std::string socket_path = "/tmp/aoc.sock";
+    std::size_t no_of_connections = 4;
+    std::size_t no_of_requests = 1000;
+    std::uint64_t seed = 1;
+    std::vector<std::string> workload_args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--socket" && has_value) {
+            socket_path = argv[++i];
+        }
+        else if (arg == "--connections" && has_value) {
+            no_of_connections = std::max<std::size_t>(std::stoul(argv[++i]), 1);
+        }
+        else if (arg == "--requests" && has_value) {
+            no_of_requests = std::stoul(argv[++i]);
+        }
+        else if (arg == "--seed" && has_value) {
+            seed = std::stoull(argv[++i]);
+        }
+        else {
+            workload_args.emplace_back(arg);
+        }
+    }
+    if (workload_args.empty()) {
+        fmt::print(stderr, "Usage: aoc-loadgen [--socket <path>] [--connections <n>] [--requests <n>] [--seed <n>] <workload>...\n");
+        return 1;
+    }
+
+    std::vector<Workload> workloads;
+    for (const auto& arg : workload_args) {
+        workloads.push_back(load_workload(arg, seed));
+    }
+
+    std::vector<ConnectionStats> per_connection(no_of_connections);
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> threads;
+        std::size_t first_request = 0;
+        for (std::size_t c = 0; c < no_of_connections; ++c) {
+            const std::size_t share = no_of_requests / no_of_connections + (c < no_of_requests % no_of_connections ? 1 : 0);
+            threads.emplace_back([&, c, first_request, share](){
+                per_connection[c] = drive(socket_path, workloads, first_request, share);
+            });
+            first_request += share;
+        }
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    std::vector<std::chrono::nanoseconds> latencies;
+    std::size_t errors = 0;
+    for (const auto& stats : per_connection) {
+        latencies.insert(latencies.end(), stats.latencies.begin(), stats.latencies.end());
+        errors += stats.errors;
+    }
+    if (latencies.empty()) return 0;
+    std::ranges::sort(latencies);
+
+    fmt::print("{} requests over {} connections in {:.3f} s: {:.0f} req/s, {} errors\n",
+               latencies.size(), no_of_connections, elapsed.count(),
+               static_cast<double>(latencies.size()) / elapsed.count(), errors);
+    fmt::print("latency us: p50 {:.1f}  p90 {:.1f}  p99 {:.1f}  p99.9 {:.1f}  max {:.1f}\n",
+               percentile_us(latencies, 50), percentile_us(latencies, 90), percentile_us(latencies, 99),
+               percentile_us(latencies, 99.9), percentile_us(latencies, 100));
+    return errors == 0 ? 0 : 1;
+}
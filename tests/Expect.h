@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <fmt/format.h>
+#include <string_view>
+
+namespace aoc::test {
+
+// Failed expectations are printed and counted, rather than stopping the test, so one run reports all of them
+inline int failures = 0;
+
+inline void expect(std::string_view name, std::int64_t got, std::int64_t want) {
+    if (got != want) {
+        fmt::print("FAIL {}: got {}, want {}\n", name, got, want);
+        ++failures;
+    }
+}
+
+// What main returns
+[[nodiscard]] inline int exit_code() {
+    return failures == 0 ? 0 : 1;
+}
+
+}
@@ -0,0 +1,48 @@
+// The arena grows to fit what spilled, up to its cap, and keeps working past it
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <string>
+
+#include "../common/Arena.h"
+#include "Expect.h"
+
+using aoc::test::expect;
+
+namespace {
+
+void expect_allocated(aoc::Arena& arena, std::size_t bytes, std::size_t alignment) {
+    /// Non-null and aligned, whether it comes from the buffer or spills
+    const void* const p = arena.resource()->allocate(bytes, alignment);
+    const std::string name = fmt::format("{} B aligned to {}", bytes, alignment);
+    expect(name + ", non-null", p != nullptr, true);
+    expect(name + ", aligned", static_cast<std::int64_t>(reinterpret_cast<std::uintptr_t>(p) % alignment), 0);
+}
+
+}
+
+int main() {
+    aoc::Arena arena {1024, 16 * 1024};
+
+    expect_allocated(arena, 512, 8);
+    arena.reset();
+    expect("no spill", arena.capacity(), 1024);
+
+    expect_allocated(arena, 4000, 8);
+    arena.reset();
+    expect("grown to fit the spill", arena.capacity(), 8 * 1024);
+
+    for (int i = 0; i < 3; ++i) {
+        expect_allocated(arena, 100 * 1024, 8);
+        arena.reset();
+        expect("capped", arena.capacity(), 16 * 1024);
+    }
+
+    expect_allocated(arena, 16 * 1024, 8);
+    arena.reset();
+    expect("still fits once capped", arena.capacity(), 16 * 1024);
+
+    expect("initial capacity over the cap", aoc::Arena{64 * 1024, 16 * 1024}.capacity(), 16 * 1024);
+
+    return aoc::test::exit_code();
+}
@@ -0,0 +1,92 @@
+// Blank lines around and between the patterns mustn't change the answers, or make empty/reversed blocks; and every
+// generated pattern has exactly one line for each part, which the solver finds
+#include <fmt/format.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/Days.h"
+#include "../common/Input.h"
+#include "../gen/Generators.h"
+#include "Expect.h"
+
+namespace {
+
+using aoc::test::expect;
+
+constexpr std::string_view sample =
+    "#.##..##.\n..#.##.#.\n##......#\n##......#\n..#.##.#.\n..##..##.\n#.#.##.#.\n"
+    "\n"
+    "#...##..#\n#....#..#\n..##..###\n#####.##.\n#####.##.\n..##..###\n#....#..#\n";
+
+struct Lines {
+    int clean = 0;      // lines the pattern reflects about as it is
+    int smudged = 0;    // lines it reflects about once one cell is flipped
+    aoc::Answer clean_summary = 0;
+    aoc::Answer smudged_summary = 0;
+};
+
+Lines reference_lines(const std::vector<std::string_view>& rows) {
+    /// Every horizontal and vertical line, by counting the cells that differ from their images
+    Lines lines;
+    const auto count = [&lines](std::size_t mismatches, aoc::Answer summary){
+        if (mismatches == 0) { ++lines.clean; lines.clean_summary += summary; }
+        if (mismatches == 1) { ++lines.smudged; lines.smudged_summary += summary; }
+    };
+    const std::size_t height = rows.size();
+    const std::size_t width = rows.front().size();
+    for (std::size_t line = 1; line < height; ++line) {
+        std::size_t mismatches = 0;
+        for (std::size_t i = 0; i < std::min(line, height - line); ++i) {
+            for (std::size_t col = 0; col < width; ++col) mismatches += rows[line - 1 - i][col] != rows[line + i][col];
+        }
+        count(mismatches, 100 * static_cast<aoc::Answer>(line));
+    }
+    for (std::size_t line = 1; line < width; ++line) {
+        std::size_t mismatches = 0;
+        for (std::size_t i = 0; i < std::min(line, width - line); ++i) {
+            for (const auto row : rows) mismatches += row[line - 1 - i] != row[line + i];
+        }
+        count(mismatches, static_cast<aoc::Answer>(line));
+    }
+    return lines;
+}
+
+}
+
+int main() {
+    expect("sample, part 1", q13::solve_part_1(sample), 405);
+    expect("sample, part 2", q13::solve_part_2(sample), 400);
+
+    const std::string sample_with_blanks = fmt::format("\n\n{}\n\n", sample);
+    expect("blank lines around, part 1", q13::solve_part_1(sample_with_blanks), 405);
+    expect("blank lines around, part 2", q13::solve_part_2(sample_with_blanks), 400);
+
+    expect("trailing blank line", q13::solve_part_1("#.\n#.\n\n##\n..\n\n"), 101);
+    expect("consecutive blank lines", q13::solve_part_1("#.\n#.\n\n\n\n##\n..\n"), 101);
+
+    for (const std::uint64_t seed : {1, 2, 3}) {
+        const std::string input = aoc::gen::generate(13, 1, seed);
+        std::vector<std::string_view> rows;
+        int pattern = 0;
+        const auto check = [&]{
+            const Lines lines = reference_lines(rows);
+            std::string text;
+            for (const auto row : rows) text += fmt::format("{}\n", row);
+            const auto name = fmt::format("seed {} pattern {}", seed, ++pattern);
+            expect(fmt::format("{}: clean lines", name), lines.clean, 1);
+            expect(fmt::format("{}: smudged lines", name), lines.smudged, 1);
+            expect(fmt::format("{}: part 1", name), q13::solve_part_1(text), lines.clean_summary);
+            expect(fmt::format("{}: part 2", name), q13::solve_part_2(text), lines.smudged_summary);
+            rows.clear();
+        };
+        for (const std::string_view line : aoc::lines(input)) {
+            if (!line.empty()) rows.push_back(line);
+            else if (!rows.empty()) check();
+        }
+        if (!rows.empty()) check();
+        expect(fmt::format("seed {}: no of patterns", seed), pattern, 100);
+    }
+
+    return aoc::test::exit_code();
+}
@@ -0,0 +1,115 @@
+// The parser and bag queries for games with other colours than red, green and blue, against a plain reference
+#define AOC_NO_MAIN
+#include "../q2.cpp"
+
+#include <cstdio>
+#include <string>
+
+#include "../gen/Generators.h"
+#include "Expect.h"
+
+namespace {
+
+using aoc::test::expect;
+
+constexpr std::array<std::string_view, 4> four {"red", "green", "blue", "yellow"};
+constexpr std::array<std::string_view, 16> sixteen {
+    "red", "green", "blue", "yellow", "black", "white", "orange", "purple",
+    "pink", "brown", "grey", "gold", "cyan", "magenta", "teal", "tan"};
+constexpr std::array<std::string_view, 4> with_prefixes {"red", "reddish", "blue", "bluegreen"}; // settled at word ends
+
+static_assert(q2::ColourSet<four>::trie.is_prefix_free);
+static_assert(q2::ColourSet<sixteen>::trie.is_prefix_free);
+static_assert(!q2::ColourSet<with_prefixes>::trie.is_prefix_free);
+
+template <std::size_t N>
+std::string generate_games(const std::array<std::string_view, N>& names, int max_count, aoc::gen::Rng& rng) {
+    /// Games in the puzzle's format, with the odd word that isn't a colour, whose count should be dropped
+    /// NB: the parser reads a word as whichever colour its first letters settle on, so the stray word mustn't start
+    /// like any of the names
+    std::string input;
+    for (int id = 1; id <= 200; ++id) {
+        input += fmt::format("Game {}:", id);
+        const auto no_of_draws = rng.between(1, 4);
+        for (std::int64_t draw = 0; draw < no_of_draws; ++draw) {
+            const auto no_of_cubes = rng.between(1, 5);
+            for (std::int64_t cube = 0; cube < no_of_cubes; ++cube) {
+                const std::string_view name = rng.chance(0.05) ? std::string_view{"violet"} : rng.pick(names);
+                input += fmt::format(" {} {}{}", rng.between(1, max_count), name, cube + 1 < no_of_cubes ? "," : "");
+            }
+            if (draw + 1 < no_of_draws) input += ';';
+        }
+        input += '\n';
+    }
+    return input;
+}
+
+template <std::size_t N>
+std::vector<q2::Counts<N>> reference_maxima(const std::array<std::string_view, N>& names, std::string_view input) {
+    /// Every game's fewest cubes, by splitting each line into "<count> <name>" pairs
+    std::vector<q2::Counts<N>> games;
+    for (const std::string_view line : aoc::lines(input)) {
+        q2::Counts<N> maxima {};
+        const auto tokens = aoc::split(line.substr(line.find(':') + 2), ' ', std::pmr::get_default_resource());
+        for (std::size_t i = 0; i + 1 < tokens.size(); i += 2) {
+            std::string_view name = tokens[i + 1];
+            while (!name.empty() && (name.back() == ',' || name.back() == ';')) name.remove_suffix(1);
+            const auto colour = std::ranges::find(names, name);
+            if (colour == names.end()) continue;
+            auto& max = maxima[static_cast<std::size_t>(colour - names.begin())];
+            max = std::max(max, std::stoi(std::string{tokens[i]}));
+        }
+        games.push_back(maxima);
+    }
+    return games;
+}
+
+template <const auto& Names>
+void check(std::string_view variant, int max_count, aoc::gen::Rng& rng) {
+    constexpr std::size_t N = Names.size();
+    const std::string input = generate_games(Names, max_count, rng);
+    const std::vector<q2::Counts<N>> want = reference_maxima(Names, input);
+
+    const q2::GameColumns<N> games = q2::read_columns<Names>(input);
+    expect(fmt::format("{}: no of games", variant), static_cast<aoc::Answer>(games.size()), static_cast<aoc::Answer>(want.size()));
+    for (std::size_t i = 0; i < std::min(games.size(), want.size()); ++i) {
+        for (std::size_t c = 0; c < N; ++c) {
+            expect(fmt::format("{}: game {} {}", variant, i + 1, Names[c]), games.columns[c][i], want[i][c]);
+        }
+    }
+
+    const q2::BagQueries<N> queries {games};
+    for (int b = 0; b < 20; ++b) {
+        q2::Counts<N> bag {};
+        for (int& count : bag) count = static_cast<int>(rng.between(0, max_count + 1));
+        aoc::Answer sum = 0;
+        for (std::size_t i = 0; i < want.size(); ++i) {
+            sum += q2::is_valid(want[i], bag) ? static_cast<aoc::Answer>(i + 1) : 0;
+        }
+        expect(fmt::format("{}: bag {}", variant, b), queries.sum_of_possible_ids(bag), sum);
+    }
+}
+
+}
+
+int main() {
+    aoc::gen::Rng rng {2023};
+    check<four>("4 colours", 20, rng);       // small enough counts for the prefix sum table
+    check<sixteen>("16 colours", 20, rng);   // too many cells, so every bag is a scan
+    check<with_prefixes>("names that are prefixes", 20, rng);
+
+    // streaming in uneven chunks splits numbers and names mid-way
+    const std::string input = generate_games(sixteen, 20, rng);
+    const q2::GameColumns<16> whole = q2::read_columns<sixteen>(input);
+    q2::GameColumns<16> chunked;
+    auto parser = q2::make_parser<sixteen>([&chunked](int, const q2::Counts<16>& min_hand){
+        for (std::size_t c = 0; c < min_hand.size(); ++c) chunked.columns[c].push_back(min_hand[c]);
+    });
+    for (std::size_t pos = 0, size = 1; pos < input.size(); pos += size, size = size % 7 + 1) {
+        parser.feed(std::string_view{input}.substr(pos, size));
+    }
+    parser.finish();
+    expect("16 colours in chunks", chunked.columns == whole.columns, true);
+
+    return aoc::test::exit_code();
+}
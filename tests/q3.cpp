@@ -0,0 +1,56 @@
+// Streaming the schematic in small chunks, so numbers and gears straddle chunk boundaries, against the whole-input solve
+#define AOC_NO_MAIN
+#include "../q3.cpp"
+
+#include <cstdio>
+#include <string>
+
+#include "../gen/Generators.h"
+#include "Expect.h"
+
+namespace {
+
+using aoc::test::expect;
+
+constexpr std::string_view sample =
+    "467..114..\n...*......\n..35..633.\n......#...\n617*......\n"
+    ".....+.58.\n..592.....\n......755.\n...$.*....\n.664.598..\n";
+
+void check(std::string_view name, std::string_view input, std::size_t chunk_size) {
+    std::FILE* file = std::tmpfile();
+    if (file == nullptr) {
+        throw std::runtime_error("Unable to open a temporary file");
+    }
+    std::fwrite(input.data(), 1, input.size(), file);
+    std::rewind(file);
+    const q3::Totals totals = q3::calc_totals(file, chunk_size);
+    std::fclose(file);
+
+    expect(fmt::format("{} in {} byte chunks, part 1", name, chunk_size), totals.part_1, q3::solve_part_1(input));
+    expect(fmt::format("{} in {} byte chunks, part 2", name, chunk_size), totals.part_2, q3::solve_part_2(input));
+}
+
+}
+
+int main() {
+    expect("sample, part 1", q3::solve_part_1(sample), 4361);
+    expect("sample, part 2", q3::solve_part_2(sample), 467835);
+
+    // every chunk size up to a row and a bit: some split "467" and "617*" (a gear's number), others split rows
+    for (std::size_t chunk_size = 1; chunk_size <= 13; ++chunk_size) {
+        check("sample", sample, chunk_size);
+    }
+    check("sample without its last newline", sample.substr(0, sample.size() - 1), 4);
+
+    // 4 byte chunks split 12345, and 12 of the gear 12 * 34
+    check("number across a boundary", "..12345.\n..*.....\n.....67.\n", 4);
+    check("gear across a boundary", "...12..\n....*34\n", 4);
+    expect("gear across a boundary, part 2", q3::solve_part_2("...12..\n....*34\n"), 408);
+
+    const std::string generated = aoc::gen::generate(3, 4, 1);
+    for (const std::size_t chunk_size : {std::size_t{7}, std::size_t{100}, std::size_t{4093}}) {
+        check("generated", generated, chunk_size);
+    }
+
+    return aoc::test::exit_code();
+}
@@ -0,0 +1,58 @@
+// Cards with hundreds of numbers are scored exactly while the answers fit, and saturate once they don't
+#include <fmt/format.h>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "../common/Days.h"
+#include "Expect.h"
+
+namespace {
+
+using aoc::test::expect;
+
+constexpr std::string_view sample =
+    "Card 1: 41 48 83 86 17 | 83 86  6 31 17  9 48 53\n"
+    "Card 2: 13 32 20 16 61 | 61 30 68 82 17 32 24 19\n"
+    "Card 3:  1 21 53 59 44 | 69 82 63 72 16 21 14  1\n"
+    "Card 4: 41 92 73 84 69 | 59 84 76 51 58  5 54 83\n"
+    "Card 5: 87 83 26 28 32 | 88 30 70 12 93 22 82 36\n"
+    "Card 6: 31 18 13 56 72 | 74 77 10 23 35 67 36 11\n";
+
+constexpr aoc::Answer max_answer = std::numeric_limits<aoc::Answer>::max();
+
+std::string card(int id, int first_winning, int no_of_winning, int first_yours, int no_of_yours) {
+    /// Runs of consecutive numbers, so the matches are wherever the runs overlap
+    std::string line = fmt::format("Card {}:", id);
+    for (int n = first_winning; n < first_winning + no_of_winning; ++n) line += fmt::format(" {}", n);
+    line += " |";
+    for (int n = first_yours; n < first_yours + no_of_yours; ++n) line += fmt::format(" {}", n);
+    return line + '\n';
+}
+
+}
+
+int main() {
+    expect("sample, part 1", q4::solve_part_1(sample), 13);
+    expect("sample, part 2", q4::solve_part_2(sample), 30);
+
+    // 300 numbers a side up to 900, overlapping in 40
+    const std::string wide = card(1, 1, 300, 261, 300);
+    expect("40 matches, part 1", q4::solve_part_1(wide), aoc::Answer{1} << 39);
+    expect("40 matches, part 2", q4::solve_part_2(wide), 1);
+
+    const std::string numbers_past_a_thousand = card(1, 1000, 200, 1190, 200);
+    expect("numbers past 1000, part 1", q4::solve_part_1(numbers_past_a_thousand), 512);
+
+    // every card wins a copy of every later one, so card i ends up with 2 ^ (i - 1) copies
+    std::string doubling;
+    for (int id = 1; id <= 70; ++id) doubling += card(id, 1, 100, 1, 100);
+    expect("100 matches a card, part 1", q4::solve_part_1(doubling), max_answer);
+    expect("2 ^ 69 copies, part 2", q4::solve_part_2(doubling), max_answer);
+
+    std::string just_fits;
+    for (int id = 1; id <= 62; ++id) just_fits += card(id, 1, 62, 1, 62);
+    expect("2 ^ 62 - 1 cards, part 2", q4::solve_part_2(just_fits), (aoc::Answer{1} << 62) - 1);
+
+    return aoc::test::exit_code();
+}
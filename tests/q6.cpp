@@ -0,0 +1,32 @@
+// The number of ways to beat a record is counted exactly, including when a root of the race's quadratic is an integer
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "../common/Days.h"
+#include "Expect.h"
+
+namespace {
+
+using aoc::test::expect;
+
+constexpr std::string_view sample = "Time:      7  15   30\nDistance:  9  40  200\n";
+
+}
+
+int main() {
+    expect("sample, part 1", q6::solve_part_1(sample), 288);
+    expect("sample, part 2", q6::solve_part_2(sample), 71503);
+
+    // the roots of t * (30 - t) = 200 are exactly 10 and 20, and holding for either only ties the record
+    expect("integer roots", q6::solve_part_1("Time: 30\nDistance: 200\n"), 9);
+    expect("record out of reach", q6::solve_part_1("Time: 10\nDistance: 25\n"), 0);
+    expect("no record", q6::solve_part_1("Time: 10\nDistance: 0\n"), 9);
+
+    const std::vector<std::string_view> inputs {sample, "Time: 30\nDistance: 200\n"};
+    const std::vector<aoc::Answer> batch = q6::solve_part_1_batch(inputs, nullptr);
+    expect("batch, sample", batch[0], 288);
+    expect("batch, integer roots", batch[1], 9);
+
+    return aoc::test::exit_code();
+}
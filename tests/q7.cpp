@@ -0,0 +1,33 @@
+// Blank lines are skipped, and the batch solvers agree with solving each input on its own
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "../common/Days.h"
+#include "Expect.h"
+
+namespace {
+
+using aoc::test::expect;
+
+constexpr std::string_view sample = "32T3K 765\nT55J5 684\nKK677 28\nKTJJT 220\nQQQJA 483\n";
+constexpr std::string_view sample_with_blanks = "\n32T3K 765\nT55J5 684\n\nKK677 28\nKTJJT 220\nQQQJA 483\n\n";
+
+}
+
+int main() {
+    expect("sample, part 1", q7::solve_part_1(sample), 6440);
+    expect("sample, part 2", q7::solve_part_2(sample), 5905);
+    expect("blank lines, part 1", q7::solve_part_1(sample_with_blanks), 6440);
+    expect("blank lines, part 2", q7::solve_part_2(sample_with_blanks), 5905);
+
+    const std::vector<std::string_view> inputs {sample, sample_with_blanks};
+    const std::vector<aoc::Answer> part_1 = q7::solve_part_1_batch(inputs, nullptr);
+    const std::vector<aoc::Answer> part_2 = q7::solve_part_2_batch(inputs, nullptr);
+    expect("batch, part 1", part_1[0], 6440);
+    expect("batch, part 2", part_2[0], 5905);
+    expect("batch with blank lines, part 1", part_1[1], 6440);
+    expect("batch with blank lines, part 2", part_2[1], 5905);
+
+    return aoc::test::exit_code();
+}
@@ -0,0 +1,34 @@
+// Predictions are summed in 64 bits, and the batch solvers agree with solving each input on its own
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "../common/Days.h"
+#include "Expect.h"
+
+namespace {
+
+using aoc::test::expect;
+
+constexpr std::string_view sample = "0 3 6 9 12 15\n1 3 6 10 15 21\n10 13 16 21 30 45\n";
+// each sequence alone fits in an int, but not their predictions' sum
+constexpr std::string_view large = "2000000000 2000000000 2000000000\n1500000000 1700000000 1900000000\n";
+
+}
+
+int main() {
+    expect("sample, part 1", q9::solve_part_1(sample), 114);
+    expect("sample, part 2", q9::solve_part_2(sample), 2);
+    expect("large, part 1", q9::solve_part_1(large), 4'100'000'000);
+    expect("large, part 2", q9::solve_part_2(large), 3'300'000'000);
+
+    const std::vector<std::string_view> inputs {sample, large};
+    const std::vector<aoc::Answer> part_1 = q9::solve_part_1_batch(inputs, nullptr);
+    const std::vector<aoc::Answer> part_2 = q9::solve_part_2_batch(inputs, nullptr);
+    expect("batch, sample, part 1", part_1[0], 114);
+    expect("batch, sample, part 2", part_2[0], 2);
+    expect("batch, large, part 1", part_1[1], 4'100'000'000);
+    expect("batch, large, part 2", part_2[1], 3'300'000'000);
+
+    return aoc::test::exit_code();
+}
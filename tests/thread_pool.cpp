@@ -0,0 +1,55 @@
+// Every task runs exactly once, whether submitted from outside, from inside a task, or through parallel_for,
+// including when the workers keep running dry and parking between bursts
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <fmt/format.h>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "../common/ThreadPool.h"
+#include "Expect.h"
+
+using aoc::test::expect;
+
+int main() {
+    for (const std::size_t no_of_threads : {1, 2, 4, 8}) {
+        aoc::ThreadPool pool {no_of_threads};
+
+        for (int burst = 0; burst < 200; ++burst) {
+            std::atomic<std::size_t> ran = 0;
+            std::vector<std::future<void>> tasks;
+            for (int i = 0; i < 10; ++i) {
+                tasks.push_back(pool.submit([&pool, &ran](){
+                    ++ran;
+                    static_cast<void>(pool.submit([&ran](){ ++ran; })); // onto this worker's own deque
+                }));
+            }
+            for (auto& task : tasks) task.get();
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (ran < 20 && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+            expect(fmt::format("{} threads, burst {}", no_of_threads, burst), ran, 20);
+            if (burst % 50 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1)); // let the workers park
+        }
+
+        std::vector<std::atomic<int>> hits(10'000);
+        aoc::parallel_for(&pool, hits.size(), [&](std::size_t begin, std::size_t end){
+            for (std::size_t i = begin; i < end; ++i) ++hits[i];
+        });
+        std::size_t no_hit_once = 0;
+        for (const auto& hit : hits) no_hit_once += (hit != 1);
+        expect(fmt::format("{} threads, parallel_for", no_of_threads), no_hit_once, 0);
+    }
+
+    std::atomic<std::size_t> ran = 0;
+    {
+        aoc::ThreadPool pool {4};
+        for (int i = 0; i < 1000; ++i) {
+            static_cast<void>(pool.submit([&ran](){ ++ran; }));
+        }
+    } // NB: the destructor runs whatever is still queued
+    expect("queued at destruction", ran, 1000);
+
+    return aoc::test::exit_code();
+}